@@ -1,7 +1,6 @@
 #ifndef CIRCLE_PHYSICS_HPP
 #define CIRCLE_PHYSICS_HPP
 
-#include <functional>
 #include <unordered_set>
 
 #include <box2d/box2d.h>
@@ -17,26 +16,37 @@ enum class CircleKind {
 
 class CirclePhysics {
 public:
+    // How the body behaves while nothing pushes it. Impulses always switch it to
+    // an awake dynamic body; restore_body_motion() puts it back once at rest.
+    enum class BodyMotion {
+        Dynamic,
+        Sleeping,
+        Static
+    };
+
     struct Config {
         b2Vec2 position;
         float radius;
         float density;
         float angle;
         CircleKind kind;
+        bool with_body;
 
         Config()
             : position{0.0f, 0.0f},
               radius(1.0f),
               density(1.0f),
               angle(0.0f),
-              kind(CircleKind::Unknown) {}
+              kind(CircleKind::Unknown),
+              with_body(true) {}
 
-        Config(b2Vec2 position_, float radius_, float density_, float angle_, CircleKind kind_)
+        Config(b2Vec2 position_, float radius_, float density_, float angle_, CircleKind kind_, bool with_body_ = true)
             : position(position_),
               radius(radius_),
               density(density_),
               angle(angle_),
-              kind(kind_) {}
+              kind(kind_),
+              with_body(with_body_) {}
     };
 
     explicit CirclePhysics(const b2WorldId &worldId, Config config = {});
@@ -58,18 +68,32 @@ public:
     void setArea(float area, const b2WorldId& worldId);
     void grow_by_area(float delta_area, const b2WorldId& worldId);
 
-    void apply_forward_force() const;
+    // Forces and impulses promote a bodyless circle to a Box2D body first.
+    void apply_forward_force();
     void apply_zero_force() const;
-    void apply_left_turn_torque() const;
-    void apply_right_turn_torque() const;
+    void apply_left_turn_torque();
+    void apply_right_turn_torque();
     void apply_zero_torque() const;
 
-    void apply_forward_impulse() const;
-    void apply_forward_impulse_at_point(const b2Vec2& world_point) const;
-    void apply_left_turn_impulse() const;
-    void apply_right_turn_impulse() const;
+    void apply_forward_impulse();
+    void apply_forward_impulse_at_point(const b2Vec2& world_point);
+    void apply_left_turn_impulse();
+    void apply_right_turn_impulse();
+
+    // Bodyless circles keep their transform locally and are invisible to Box2D;
+    // the owner is responsible for their touch detection.
+    bool has_body() const { return b2Body_IsValid(bodyId); }
+    void ensure_body();
+    void release_body();
+    void clear_touching();
+    void set_body_motion(BodyMotion motion);
+    BodyMotion get_body_motion() const { return bodyMotion; }
+    bool is_at_rest() const;
+    void restore_body_motion();
 
     float getAngle() const;
+    // Refreshes the cached transform from a step's move event; see process_body_move_events().
+    void sync_from_move_event(const b2BodyMoveEvent& event);
 
     void set_density(float new_density, const b2WorldId& worldId);
     void set_impulse_magnitudes(float linear, float angular);
@@ -83,8 +107,24 @@ public:
     void setPosition(const b2Vec2& new_position, const b2WorldId &worldId);
     void setAngle(float new_angle, const b2WorldId &worldId);
     CircleKind get_kind() const { return kind; }
-    void for_each_touching(const std::function<void(CirclePhysics&)>& fn);
-    void for_each_touching(const std::function<void(const CirclePhysics&)>& fn) const;
+    // Re-reads the world's CollisionFilter for this circle's kind.
+    void refresh_collision_filter();
+    template <typename Fn>
+    void for_each_touching(Fn&& fn) {
+        for (auto* c : touching_circles) {
+            if (c) {
+                fn(*c);
+            }
+        }
+    }
+    template <typename Fn>
+    void for_each_touching(Fn&& fn) const {
+        for (const auto* c : touching_circles) {
+            if (c) {
+                fn(*c);
+            }
+        }
+    }
 private:
     void set_cached_radius(float r) { radius_cached = r; }
 
@@ -96,13 +136,31 @@ private:
         float radius;
     };
 
+    // Last known transform and velocity of the body, so repeated reads within a tick
+    // do not go back into Box2D. Filled on body creation and from move events, and
+    // dropped whenever something other than the solver changes the velocity.
+    struct MotionCache {
+        b2Vec2 position;
+        b2Rot rotation;
+        b2Vec2 linearVelocity;
+        bool valid = false;
+    };
+
+    const MotionCache& motion() const;
+    void invalidate_motion() { motionCache.valid = false; }
+
     BodyState captureBodyState() const;
     b2BodyDef buildBodyDef(const BodyState& state) const;
     b2ShapeDef buildCircleShapeDef() const;
     void createBodyWithState(const b2WorldId& worldId, const BodyState& state);
     void recreateBodyWithState(const b2WorldId& worldId, const BodyState& state);
+    void prepare_for_push();
 
     b2BodyId bodyId;
+    b2WorldId ownerWorldId;
+    BodyState detachedState;
+    mutable MotionCache motionCache;
+    BodyMotion bodyMotion = BodyMotion::Dynamic;
     float density;
     bool isSensor;
     bool enableSensorEvents;
@@ -114,7 +172,26 @@ private:
     CircleKind kind;
 protected:
     std::unordered_set<CirclePhysics*> touching_circles;
-    void set_kind(CircleKind k) { kind = k; }
+    void set_kind(CircleKind k);
+    // Called only when the touching set actually changes (sensor begin/end or teardown).
+    virtual void on_touching_added(CirclePhysics* circle_physics) { (void)circle_physics; }
+    virtual void on_touching_removed(CirclePhysics* circle_physics) { (void)circle_physics; }
+    virtual void on_radius_changed() {}
 };
 
+// Kind-tag dispatch used instead of dynamic_cast on hot paths. Each circle class
+// specialises circle_kind_matches<T> in its own header.
+template <typename T>
+bool circle_kind_matches(CircleKind kind);
+
+template <typename T>
+T* circle_cast(CirclePhysics* circle) {
+    return (circle && circle_kind_matches<T>(circle->get_kind())) ? static_cast<T*>(circle) : nullptr;
+}
+
+template <typename T>
+const T* circle_cast(const CirclePhysics* circle) {
+    return (circle && circle_kind_matches<T>(circle->get_kind())) ? static_cast<const T*>(circle) : nullptr;
+}
+
 #endif
@@ -0,0 +1,35 @@
+#ifndef COLLISION_FILTER_HPP
+#define COLLISION_FILTER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <box2d/box2d.h>
+
+#include "circle_physics.hpp"
+
+// Symmetric matrix of which circle kinds produce Box2D overlap pairs with each other,
+// turned into per-kind category and mask bits. A dish stores its matrix as the world's
+// user data so every shape built in that world picks it up.
+class CollisionFilter {
+public:
+    static constexpr std::size_t KIND_COUNT = static_cast<std::size_t>(CircleKind::BoostParticle) + 1;
+
+    // Only pairs that involve a creature: sensors, eating, and collisions all need one.
+    CollisionFilter();
+
+    void set_pair(CircleKind a, CircleKind b, bool enabled);
+    bool get_pair(CircleKind a, CircleKind b) const;
+    b2Filter filter_for(CircleKind kind) const;
+
+    // The filter installed on the world, or the default matrix if there is none.
+    static const CollisionFilter& for_world(b2WorldId world);
+
+private:
+    static std::uint64_t category_bit(CircleKind kind) { return std::uint64_t{1} << static_cast<std::size_t>(kind); }
+
+    std::array<std::uint64_t, KIND_COUNT> masks{};
+};
+
+#endif
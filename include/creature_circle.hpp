@@ -2,12 +2,15 @@
 #define CREATURE_CIRCLE_HPP
 
 #include "eatable_circle.hpp"
+#include "game/innovation_registry.hpp"
 #include "simulation_config.hpp"
 #include <NEAT/genome.hpp>
 
 #include <algorithm>
 #include <array>
+#include <cstdint>
 #include <memory>
+#include <span>
 #include <utility>
 #include <vector>
 
@@ -27,21 +30,36 @@ public:
                 float init_add_node_thresh = 0.8f,
                 float init_add_connection_thresh = 1.0f,
                 const neat::Genome* base_brain = nullptr,
-                std::vector<std::vector<int>>* innov_ids = nullptr,
-                int* last_innov_id = nullptr,
-                Game* owner = nullptr);
+                InnovationRegistry* innovations = nullptr,
+                Game* owner = nullptr,
+                std::shared_ptr<neat::Genome> shared_brain = nullptr);
+    ~CreatureCircle() override;
 
     void set_minimum_area(float area) { minimum_area = area; }
     float get_minimum_area() const { return minimum_area; }
     int get_generation() const { return generation; }
     void set_generation(int g) { generation = std::max(0, g); }
-    const neat::Genome& get_brain() const { return brain; }
+    const neat::Genome& get_brain() const { return *brain; }
+    // True while this creature still shares its genome with a clone from division.
+    bool is_brain_shared() const { return brain.use_count() > 1; }
+    // Bumped whenever the genome changes so anything derived from it can rebuild lazily.
+    std::uint32_t get_genome_version() const { return genome_version; }
+    // No enabled connection cycle, so a run keeps no state for the next one. Cached per genome version.
+    bool has_feedforward_brain() const;
+    // What this creature last fed its brain and got back; a shared genome only holds the last clone's run.
+    std::span<const float> get_brain_inputs() const { return brain_inputs; }
+    std::span<const float> get_brain_outputs() const { return brain_outputs; }
 
     void process_eating(const b2WorldId &worldId, Game& game, float poison_death_probability_toxic, float poison_death_probability_normal);
     void update_inactivity(float dt, float timeout);
 
     void move_randomly(const b2WorldId &worldId, Game &game);
     void move_intelligently(const b2WorldId &worldId, Game &game, float dt);
+    // Thresholds are multiplied by rate_scale (clamped to 1) for scheduled live mutation.
+    void apply_live_mutation(const Game& game, float rate_scale = 1.0f);
+    int& live_mutation_countdown() { return ticks_until_live_mutation; }
+    // Sim time since this creature's last brain update when brain updates are staggered.
+    float& brain_update_accumulator() { return brain_time_accumulator; }
 
     void boost_forward(const b2WorldId &worldId, Game& game);
     void boost_eccentric_forward_right(const b2WorldId &worldId, Game& game);
@@ -49,13 +67,17 @@ public:
     void divide(const b2WorldId &worldId, Game& game);
 
     bool is_poisoned() const { return poisoned; }
-    void set_creation_time(float t) { creation_time = t; }
+    void set_creation_time(float t);
     float get_creation_time() const { return creation_time; }
-    void set_last_division_time(float t) { last_division_time = t; }
+    void set_last_division_time(float t);
     float get_last_division_time() const { return last_division_time; }
+    std::uint64_t get_parent_entity_id() const { return parent_entity_id; }
 
 protected:
     bool should_draw_direction_indicator() const override { return true; }
+    void on_touching_added(CirclePhysics* circle_physics) override;
+    void on_touching_removed(CirclePhysics* circle_physics) override;
+    void on_radius_changed() override;
 
 private:
     static constexpr int SENSOR_COUNT = kColorSensorCount;
@@ -66,8 +88,12 @@ private:
     static constexpr int MEMORY_INPUT_START = SIZE_INPUT_INDEX + 1;
     static constexpr int BRAIN_INPUTS = SENSOR_INPUTS + 1 + MEMORY_SLOTS;
 
+    static std::shared_ptr<neat::Genome> copy_base_brain(const neat::Genome& base_brain, Game* owner);
+    static std::shared_ptr<neat::Genome> create_initial_brain(InnovationRegistry* innovations, float weight_extremum_init);
+    neat::Genome& mutable_brain();
     void initialize_brain(int mutation_rounds, float add_node_thresh, float add_connection_thresh);
-    void run_brain_cycle_from_touching();
+    // Returns false when the last outputs were reused because nothing the network sees changed.
+    bool run_brain_cycle_from_touching(bool reuse_unchanged = false);
     void update_brain_inputs_from_touching();
     void apply_sensor_inputs(const std::array<std::array<float, 3>, SENSOR_COUNT>& summed_colors, const std::array<float, SENSOR_COUNT>& weights);
     void write_size_and_memory_inputs();
@@ -82,25 +108,52 @@ private:
                                                           float new_radius,
                                                           float angle,
                                                           int next_generation,
-                                                          const b2Vec2& child_position,
-                                                          const neat::Genome& parent_brain_copy);
+                                                          const b2Vec2& child_position);
     void apply_post_division_updates(Game& game, CreatureCircle* child, int next_generation);
-    void configure_child_after_division(CreatureCircle& child, const b2WorldId& worldId, const Game& game, float angle, const neat::Genome& parent_brain_copy) const;
+    void configure_child_after_division(CreatureCircle& child, const b2WorldId& worldId, const Game& game, float angle) const;
     void mutate_lineage(const Game& game, CreatureCircle* child);
 
-    neat::Genome brain;
+    // Feedforward genomes are shared with division clones until one side mutates
+    // (copy-on-write through mutable_brain()); recurrent ones are copied at division.
+    std::shared_ptr<neat::Genome> brain;
+    // Eatable circles currently touching us; maintained from sensor begin/end events.
+    std::vector<EatableCircle*> eat_candidates;
     std::array<float, BRAIN_INPUTS> brain_inputs{};
     std::array<float, BRAIN_OUTPUTS> brain_outputs{};
     std::array<float, MEMORY_SLOTS> memory_state{};
-    std::vector<std::vector<int>>* neat_innovations = nullptr;
-    int* neat_last_innov_id = nullptr;
+    // Inputs and genome behind brain_outputs. A feedforward genome fed bit-identical
+    // inputs yields the same outputs, so evaluation can be skipped.
+    struct BrainEvaluation {
+        std::array<float, BRAIN_INPUTS> inputs{};
+        const neat::Genome* genome = nullptr;
+        std::uint32_t genome_version = 0;
+        bool valid = false;
+    };
+    BrainEvaluation last_evaluation;
+    struct TopologyCache {
+        const neat::Genome* genome = nullptr;
+        std::uint32_t genome_version = 0;
+        bool feedforward = false;
+        bool valid = false;
+    };
+    mutable TopologyCache topology;
+    InnovationRegistry* neat_innovations = nullptr;
+    std::uint32_t genome_version = 0;
+    int ticks_until_live_mutation = -1;
+    float brain_time_accumulator = 0.0f;
     float minimum_area = 1.0f;
     bool poisoned = false;
     int generation = 0;
+    std::uint64_t parent_entity_id = 0;
     float inactivity_timer = 0.0f;
     float creation_time = 0.0f;
     float last_division_time = 0.0f;
     Game* owner_game = nullptr;
 };
 
+template <>
+inline bool circle_kind_matches<CreatureCircle>(CircleKind kind) {
+    return kind == CircleKind::Creature;
+}
+
 #endif
@@ -0,0 +1,54 @@
+#ifndef DISH_POOL_HPP
+#define DISH_POOL_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "game.hpp"
+
+// Owns several independent dishes (own Box2D world, RNG stream, and innovation
+// table each) and steps them on a small worker pool.
+class DishPool {
+public:
+    // Box2D caps the number of live worlds per process.
+    static constexpr std::size_t MAX_DISHES = 128;
+
+    DishPool(std::size_t dish_count, std::size_t thread_count, std::uint32_t base_seed);
+    ~DishPool();
+
+    DishPool(const DishPool&) = delete;
+    DishPool& operator=(const DishPool&) = delete;
+
+    std::size_t size() const { return dishes.size(); }
+    Game& dish(std::size_t index) { return *dishes[index]; }
+    const Game& dish(std::size_t index) const { return *dishes[index]; }
+
+    // Runs fn on every dish, spread across the workers and the calling thread,
+    // and returns once all dishes are done. Dishes never share state, so fn may
+    // touch only the Game it is given.
+    void for_each_parallel(const std::function<void(Game&)>& fn);
+    // Same, but fn also receives the dish index.
+    void for_each_parallel_indexed(const std::function<void(std::size_t, Game&)>& fn);
+
+private:
+    void worker_loop();
+    void run_claimed_jobs();
+
+    std::vector<std::unique_ptr<Game>> dishes;
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable work_ready;
+    std::condition_variable work_done;
+    const std::function<void(std::size_t, Game&)>* job = nullptr;
+    std::size_t next_dish = 0;
+    std::size_t finished_dishes = 0;
+    std::uint64_t job_generation = 0;
+    bool stopping = false;
+};
+
+#endif
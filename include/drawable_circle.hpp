@@ -15,9 +15,11 @@ public:
                    float radius = 1.0f,
                    float density = 1.0f,
                    float angle = 0.0f,
-                   CircleKind kind = CircleKind::Unknown);
+                   CircleKind kind = CircleKind::Unknown,
+                   bool with_body = true);
 
-    void draw(sf::RenderWindow& window) const;
+    void draw(sf::RenderTarget& target) const;
+    sf::Color get_fill_color() const;
     void set_color_rgb(float r, float g, float b);
     const std::array<float, 3>& get_color_rgb() const { return color_rgb; }
     const std::array<float, 3>& get_display_color_rgb() const { return display_color_rgb; }
@@ -33,4 +35,10 @@ protected:
     virtual bool should_draw_direction_indicator() const { return false; }
 };
 
+template <>
+inline bool circle_kind_matches<DrawableCircle>(CircleKind kind) {
+    // Every tagged circle in the dish is drawable; Unknown only marks moved-from husks.
+    return kind != CircleKind::Unknown;
+}
+
 #endif
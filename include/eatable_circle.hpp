@@ -3,6 +3,8 @@
 
 #include "drawable_circle.hpp"
 
+#include <cstdint>
+
 class CreatureCircle;
 
 class EatableCircle : public DrawableCircle {
@@ -15,7 +17,8 @@ public:
                   bool toxic = false,
                   bool division_pellet = false,
                   float angle = 0.0f,
-                  bool boost_particle = false);
+                  bool boost_particle = false,
+                  bool with_body = true);
     void be_eaten();
     void set_eaten_by(const CreatureCircle* creature) { eaten_by = creature; }
     const CreatureCircle* get_eaten_by() const { return eaten_by; }
@@ -25,6 +28,9 @@ public:
     bool is_division_pellet() const { return division_pellet; }
     void set_division_pellet(bool value) { division_pellet = value; update_kind_from_flags(); }
     bool is_boost_particle() const { return boost_particle; }
+    // Dish-unique, assigned when the circle enters the game; 0 until then.
+    std::uint64_t get_entity_id() const { return entity_id; }
+    void set_entity_id(std::uint64_t id) { entity_id = id; }
 private:
     void update_kind_from_flags();
     bool eaten = false;
@@ -32,6 +38,31 @@ private:
     bool division_pellet = false;
     bool boost_particle = false;
     const CreatureCircle* eaten_by = nullptr;
+    std::uint64_t entity_id = 0;
 };
 
+template <>
+inline bool circle_kind_matches<EatableCircle>(CircleKind kind) {
+    switch (kind) {
+        case CircleKind::Creature:
+        case CircleKind::Pellet:
+        case CircleKind::ToxicPellet:
+        case CircleKind::DivisionPellet:
+        case CircleKind::BoostParticle:
+            return true;
+        case CircleKind::Unknown:
+            break;
+    }
+    return false;
+}
+
+inline bool is_pellet_kind(CircleKind kind) {
+    return kind == CircleKind::Pellet || kind == CircleKind::ToxicPellet || kind == CircleKind::DivisionPellet;
+}
+
+inline CircleKind pellet_kind_for(bool toxic, bool division_pellet) {
+    if (division_pellet) return CircleKind::DivisionPellet;
+    return toxic ? CircleKind::ToxicPellet : CircleKind::Pellet;
+}
+
 #endif
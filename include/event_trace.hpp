@@ -0,0 +1,93 @@
+#ifndef EVENT_TRACE_HPP
+#define EVENT_TRACE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Binary trace of lineage events. The simulation thread appends fixed-size records to a
+// single-producer ring; a background thread drains the ring to disk. When the writer falls
+// behind, events are dropped (and counted) rather than stalling the simulation.
+//
+// File layout: "PDEV" u32 version, u32 record size, then raw Event records.
+namespace event_trace {
+
+constexpr std::uint32_t FORMAT_VERSION = 1;
+
+enum class EventType : std::uint8_t {
+    Birth = 0,    // subject = newborn creature, other = parent (0 when spawned or migrated in)
+    Death = 1,    // subject = creature, detail = DeathCause
+    Eat = 2,      // subject = eater, other = eaten circle, detail = eaten CircleKind
+    Division = 3  // subject = parent, other = child
+};
+
+enum class DeathCause : std::uint8_t {
+    Removed = 0,
+    Poisoned = 1,
+    Eaten = 2
+};
+
+struct Event {
+    std::uint32_t tick = 0;
+    EventType type = EventType::Birth;
+    std::uint8_t detail = 0;
+    std::uint16_t reserved = 0;
+    std::uint64_t subject = 0;
+    std::uint64_t other = 0;
+    float x = 0.0f;
+    float y = 0.0f;
+};
+static_assert(sizeof(Event) == 32, "Event records are written to disk as-is.");
+
+class Recorder {
+public:
+    explicit Recorder(std::size_t capacity_log2 = 16);
+    ~Recorder();
+
+    bool open(const std::string& path);
+    void close();
+
+    // Called from the simulation thread only.
+    void record(const Event& event) {
+        const std::uint64_t head = write_index.load(std::memory_order_relaxed);
+        if (head - read_index.load(std::memory_order_acquire) >= ring.size()) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        ring[head & mask] = event;
+        write_index.store(head + 1, std::memory_order_release);
+    }
+
+    std::uint64_t get_recorded_count() const { return write_index.load(std::memory_order_relaxed); }
+    std::uint64_t get_dropped_count() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    void drain();
+    void writer_loop();
+
+    std::vector<Event> ring;
+    std::uint64_t mask;
+    std::atomic<std::uint64_t> write_index{0};
+    std::atomic<std::uint64_t> read_index{0};
+    std::atomic<std::uint64_t> dropped{0};
+    std::atomic<bool> stopping{false};
+    std::ofstream out;
+    std::thread writer;
+};
+
+// Sequential reader for the tools; no threads involved.
+class Reader {
+public:
+    bool open(const std::string& path, std::string& error);
+    bool next(Event& event);
+
+private:
+    std::ifstream in;
+};
+
+} // namespace event_trace
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef FRAME_CAPTURE_HPP
+#define FRAME_CAPTURE_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+#include "dish_pool.hpp"
+
+// Time-lapse capture over a DishPool: every interval of sim time each dish is drawn
+// into an offscreen texture on the calling thread, and its pixels are read straight
+// into a pooled buffer and handed to encoder threads. Frame buffers come from a small pool; when every buffer is still
+// being encoded the frame is dropped instead of stalling the simulation.
+class FrameCapture {
+public:
+    enum class Format {
+        Png,
+        Raw // headerless RGBA8, e.g. for ffmpeg -f rawvideo -pix_fmt rgba
+    };
+
+    struct Settings {
+        std::string prefix;
+        float interval = 10.0f;
+        sf::Vector2u size{1280, 720};
+        Format format = Format::Png;
+        std::size_t encoder_threads = 0; // 0 picks half the hardware threads
+    };
+
+    explicit FrameCapture(DishPool& pool);
+    ~FrameCapture();
+
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    bool start(const Settings& new_settings, std::string& error);
+    // Waits for queued frames to be written.
+    void stop();
+    bool is_active() const { return active; }
+
+    // Call on the rendering thread after each pool step.
+    void update();
+
+    std::size_t get_written_count() const { return written.load(std::memory_order_relaxed); }
+    std::size_t get_dropped_count() const { return dropped.load(std::memory_order_relaxed); }
+    std::size_t get_failed_count() const { return failed.load(std::memory_order_relaxed); }
+
+private:
+    struct Job {
+        std::size_t dish = 0;
+        std::size_t frame = 0;
+        std::vector<std::uint8_t> pixels;
+    };
+
+    void capture_dish(std::size_t index);
+    bool acquire_buffer(std::vector<std::uint8_t>& buffer);
+    void release_buffer(std::vector<std::uint8_t>&& buffer);
+    void encoder_loop();
+    void encode(const Job& job);
+    std::string frame_path(std::size_t dish, std::size_t frame) const;
+
+    DishPool& pool;
+    Settings settings;
+    bool active = false;
+    std::unique_ptr<sf::RenderTexture> target;
+    std::vector<float> next_time;
+    std::vector<std::size_t> frame_counts;
+
+    std::mutex mutex;
+    std::condition_variable work_ready;
+    std::deque<Job> queue;
+    std::vector<std::vector<std::uint8_t>> free_buffers;
+    std::size_t allocated_buffers = 0;
+    std::size_t max_buffers = 0;
+    bool stopping = false;
+    std::vector<std::thread> encoders;
+
+    std::atomic<std::size_t> written{0};
+    std::atomic<std::size_t> dropped{0};
+    std::atomic<std::size_t> failed{0};
+};
+
+#endif
@@ -4,13 +4,28 @@
 #include <vector>
 #include <optional>
 #include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
 
 #include <SFML/Graphics.hpp>
 #include <box2d/box2d.h>
 
+#include "collision_filter.hpp"
 #include "eatable_circle.hpp"
+#include "game/age_index.hpp"
+#include "game/genome_pool.hpp"
+#include "game/innovation_registry.hpp"
+#include "game/lod_renderer.hpp"
+#include "game/pellet_grid.hpp"
+#include "game/qos_governor.hpp"
 #include "game/selection_manager.hpp"
 #include "game/spawner.hpp"
+#include "game/view_culler.hpp"
+#include "event_trace.hpp"
+#include "telemetry.hpp"
 #include <NEAT/genome.hpp>
 
 class CreatureCircle;
@@ -30,12 +45,20 @@ public:
         ToxicPellet,
         DivisionPellet
     };
+    enum class MigrantRank {
+        Oldest,
+        Largest
+    };
+    // A creature leaving its dish for another island: just what is needed to respawn it.
+    struct Migrant {
+        neat::Genome brain;
+        float area;
+        int generation;
+    };
     enum class SelectionMode {
         Manual = 0,
         OldestLargest,
-#ifndef NDEBUG
         OldestMedian,
-#endif
         OldestSmallest
     };
 private:
@@ -47,6 +70,7 @@ private:
         float last_real_dt = 0.0f;
         float last_sim_dt = 0.0f;
         float actual_sim_speed_inst = 0.0f;
+        std::uint32_t tick = 0;
     };
     struct FpsStats {
         float accum_time = 0.0f;
@@ -56,6 +80,11 @@ private:
     struct BrainSettings {
         float updates_per_second = 10.0f;
         float time_accumulator = 0.0f;
+        bool staggered = false;
+        float next_phase = 0.0f;
+        bool skip_unchanged_inputs = false;
+        std::size_t evaluations = 0;
+        std::size_t reused = 0;
     };
     struct CreatureSettings {
         float minimum_area = 1.0f;
@@ -88,6 +117,8 @@ private:
         std::size_t food_count_cached = 0;
         std::size_t toxic_count_cached = 0;
         std::size_t division_count_cached = 0;
+        bool lightweight = false;
+        CirclePhysics::BodyMotion body_motion = CirclePhysics::BodyMotion::Dynamic;
     };
     struct MutationSettings {
         float add_node_thresh = 0.005f;
@@ -96,6 +127,9 @@ private:
         float tick_add_connection_thresh = 0.0f;
         float weight_extremum_init = 0.0f;
         bool live_mutation_enabled = false;
+        bool scheduled_live_mutation = false;
+        // Event probability the creatures' countdowns were sampled with; 0 while unscheduled.
+        float scheduled_probability = 0.0f;
         float mutate_weight_thresh = 0.05f;
         float mutate_weight_full_change_thresh = 0.0f;
         float mutate_weight_factor = 0.2f;
@@ -133,17 +167,35 @@ private:
         int max_generation = 0;
         std::optional<neat::Genome> brain;
     };
-    struct InnovationState {
-        std::vector<std::vector<int>> innovations;
-        int last_innovation_id = 0;
+    struct InnovationCompaction {
+        float interval = 120.0f;
+        float next_time = 120.0f;
+        std::size_t last_dropped = 0;
+    };
+    struct TelemetryState {
+        std::unique_ptr<telemetry::Writer> writer;
+        float interval = 1.0f;
+        float next_time = 0.0f;
+        std::size_t births = 0;
+        std::size_t arrivals = 0;
+        std::size_t creatures_at_last_sample = 0;
+        float sim_time_at_last_sample = 0.0f;
+        std::chrono::steady_clock::time_point started{};
+        std::chrono::steady_clock::time_point last_sample{};
+    };
+    // Filled by the const draw(); the culler and LOD buffers are per-frame scratch.
+    struct RenderState {
+        bool view_culling = true;
+        bool level_of_detail = true;
+        ViewCuller culler;
+        LodRenderer lod;
+        std::vector<std::uint32_t> visible;
+        std::size_t drawn = 0;
+        std::size_t total = 0;
     };
     struct AgeStats {
         float max_age_since_creation = 0.0f;
         float max_age_since_division = 0.0f;
-        float min_creation_time = 0.0f;
-        float min_division_time = 0.0f;
-        bool has_creature = false;
-        bool dirty = true;
     };
     struct PossesingSelectedCreature {
         bool possess_selected_creature = false;
@@ -155,11 +207,11 @@ private:
 
 public:
 
-    Game();
+    explicit Game(std::uint32_t seed = std::random_device{}());
     ~Game();
     void process_game_logic_with_speed();
     void process_game_logic();
-    void draw(sf::RenderWindow& window) const;
+    void draw(sf::RenderTarget& target) const;
     void process_input_events(sf::RenderWindow& window, const std::optional<sf::Event>& event);
     void set_time_scale(float scale) { timing.time_scale = scale; }
     float get_time_scale() const { return timing.time_scale; }
@@ -167,6 +219,13 @@ public:
     bool is_paused() const { return paused; }
     void set_brain_updates_per_sim_second(float hz) { brain.updates_per_second = hz; }
     float get_brain_updates_per_sim_second() const { return brain.updates_per_second; }
+    void set_staggered_brain_updates(bool enabled) { brain.staggered = enabled; }
+    bool get_staggered_brain_updates() const { return brain.staggered; }
+    void set_skip_unchanged_brain_inputs(bool enabled) { brain.skip_unchanged_inputs = enabled; }
+    bool get_skip_unchanged_brain_inputs() const { return brain.skip_unchanged_inputs; }
+    void count_brain_evaluation(bool evaluated) { ++(evaluated ? brain.evaluations : brain.reused); }
+    std::size_t get_brain_evaluation_count() const { return brain.evaluations; }
+    std::size_t get_brain_reuse_count() const { return brain.reused; }
     void set_minimum_area(float area) { creature.minimum_area = area; }
     float get_minimum_area() const { return creature.minimum_area; }
     void set_cursor_mode(CursorMode mode) { cursor.mode = mode; }
@@ -193,6 +252,8 @@ public:
     float get_weight_extremum_init() const { return mutation.weight_extremum_init; }
     void set_live_mutation_enabled(bool enabled) { mutation.live_mutation_enabled = enabled; }
     bool get_live_mutation_enabled() const { return mutation.live_mutation_enabled; }
+    void set_scheduled_live_mutation(bool enabled) { mutation.scheduled_live_mutation = enabled; }
+    bool get_scheduled_live_mutation() const { return mutation.scheduled_live_mutation; }
     void set_mutate_weight_thresh(float v) { mutation.mutate_weight_thresh = std::clamp(v, 0.0f, 1.0f); }
     float get_mutate_weight_thresh() const { return mutation.mutate_weight_thresh; }
     void set_mutate_weight_full_change_thresh(float v) { mutation.mutate_weight_full_change_thresh = std::clamp(v, 0.0f, 1.0f); }
@@ -217,8 +278,31 @@ public:
     int get_mutation_rounds() const { return mutation.mutation_rounds; }
     int get_max_generation() const { return generation.max_generation; }
     const neat::Genome* get_max_generation_brain() const { return generation.brain ? &(*generation.brain) : nullptr; }
-    std::vector<std::vector<int>>* get_neat_innovations() { return &innovation.innovations; }
-    int* get_neat_last_innovation_id() { return &innovation.last_innovation_id; }
+    InnovationRegistry& get_innovation_registry() { return innovations; }
+    const InnovationRegistry& get_innovation_registry() const { return innovations; }
+    GenomePool& get_genome_pool() { return genome_pool; }
+    const GenomePool& get_genome_pool() const { return genome_pool; }
+    std::size_t get_shared_brain_count() const;
+    AgeIndex& get_age_index() { return age_index; }
+    QosGovernor& get_qos_governor() { return qos; }
+    const CollisionFilter& get_collision_filter() const { return collision_filter; }
+    void set_collision_pair(CircleKind a, CircleKind b, bool enabled);
+    const QosGovernor& get_qos_governor() const { return qos; }
+    bool start_telemetry(const std::string& path, float interval_seconds);
+    void stop_telemetry();
+    bool is_telemetry_active() const { return telemetry.writer != nullptr; }
+    bool start_event_trace(const std::string& path);
+    void stop_event_trace();
+    const event_trace::Recorder* get_event_trace() const { return event_recorder.get(); }
+    void trace_event(event_trace::EventType type, const EatableCircle& subject, std::uint64_t other = 0, std::uint8_t detail = 0) {
+        if (event_recorder) {
+            record_trace_event(type, subject, other, detail);
+        }
+    }
+    void set_innovation_compaction_interval(float seconds) { innovation_compaction.interval = std::max(0.0f, seconds); }
+    float get_innovation_compaction_interval() const { return innovation_compaction.interval; }
+    std::size_t get_last_innovation_compaction_dropped() const { return innovation_compaction.last_dropped; }
+    std::size_t compact_innovations();
     void set_inactivity_timeout(float t) { death.inactivity_timeout = std::max(0.0f, t); }
     float get_inactivity_timeout() const { return death.inactivity_timeout; }
     void set_linear_impulse_magnitude(float m);
@@ -265,6 +349,18 @@ public:
     std::size_t get_food_pellet_count() const;
     std::size_t get_toxic_pellet_count() const;
     std::size_t get_division_pellet_count() const;
+    void set_lightweight_pellets(bool enabled);
+    bool get_lightweight_pellets() const { return pellets.lightweight; }
+    std::size_t get_lightweight_pellet_count() const { return pellet_grid.size(); }
+    void set_view_culling(bool enabled) { render.view_culling = enabled; }
+    bool get_view_culling() const { return render.view_culling; }
+    std::size_t get_drawn_circle_count() const { return render.drawn; }
+    std::size_t get_drawable_circle_count() const { return render.total; }
+    void set_level_of_detail(bool enabled) { render.level_of_detail = enabled; }
+    bool get_level_of_detail() const { return render.level_of_detail; }
+    const LodRenderer::Stats& get_lod_stats() const { return render.lod.get_stats(); }
+    void set_pellet_body_motion(CirclePhysics::BodyMotion motion);
+    CirclePhysics::BodyMotion get_pellet_body_motion() const { return pellets.body_motion; }
     void update_max_generation_from_circle(const EatableCircle* circle);
     void recompute_max_generation();
     void set_show_true_color(bool value) { show_true_color = value; }
@@ -276,6 +372,8 @@ public:
     bool get_up_key_down() const { return possesing.up_key_down; }
     bool get_space_key_down() const { return possesing.space_key_down; }
     void add_circle(std::unique_ptr<EatableCircle> circle);
+    std::vector<Migrant> export_migrants(std::size_t count, MigrantRank rank) const;
+    void import_migrants(std::vector<Migrant> migrants);
     std::size_t get_creature_count() const;
     void remove_random_percentage(float percentage);
     void remove_percentage_pellets(float percentage, bool toxic, bool division_pellet);
@@ -301,15 +399,17 @@ public:
     const CreatureCircle* get_selected_creature() const;
     const CreatureCircle* get_oldest_largest_creature() const;
     const CreatureCircle* get_oldest_smallest_creature() const;
-#ifndef NDEBUG
     const CreatureCircle* get_oldest_middle_creature() const;
-#endif
     const CreatureCircle* get_follow_target_creature() const;
     void set_selection_to_creature(const CreatureCircle* creature);
     const CreatureCircle* find_nearest_creature(const b2Vec2& pos) const;
     int get_selected_generation() const;
     bool select_circle_at_world(const b2Vec2& pos);
     CursorMode get_cursor_mode() const { return cursor.mode; }
+    // Per-dish random stream; every stochastic decision in the simulation draws from it.
+    float random_unit() { return std::uniform_real_distribution<float>(0.0f, 1.0f)(rng); }
+    std::mt19937& get_rng() { return rng; }
+    std::uint32_t get_seed() const { return seed; }
 private:
     struct RemovalResult {
         bool should_remove = false;
@@ -332,8 +432,16 @@ private:
     void pan_view(sf::RenderWindow& window, const sf::Event::MouseMoved& e);
     void update_creatures(const b2WorldId& worldId, float dt);
     void run_brain_updates(const b2WorldId& worldId, float timeStep);
+    void update_creature_brain(const b2WorldId& worldId, CreatureCircle& creature_circle, float brain_period, float mutation_probability);
+    float next_brain_phase();
+    float live_mutation_event_probability() const;
+    int sample_ticks_until_live_mutation(float event_probability);
+    void run_scheduled_live_mutation(CreatureCircle& creature_circle, float event_probability);
+    void reset_live_mutation_countdowns();
     void cull_consumed();
     void remove_stopped_boost_particles();
+    void settle_pushed_pellets();
+    void update_lightweight_pellet_touches();
     void apply_impulse_magnitudes_to_circles();
     void apply_damping_to_circles();
     void adjust_pellet_count(const EatableCircle* circle, int delta);
@@ -344,11 +452,14 @@ private:
     void handle_key_press(sf::RenderWindow& window, const sf::Event::KeyPressed& e);
     void handle_key_release(const sf::Event::KeyReleased& e);
     void update_max_ages();
-    void mark_age_dirty();
     void mark_selection_dirty();
     void adjust_cleanup_rates();
     void cleanup_pellets_by_rate(float timeStep);
     void finalize_world_state();
+    void compact_innovations_if_due();
+    void record_telemetry_if_due();
+    void record_trace_event(event_trace::EventType type, const EatableCircle& subject, std::uint64_t other, std::uint8_t detail);
+    telemetry::Record collect_telemetry_record();
     std::size_t count_pellets(bool toxic, bool division_pellet) const;
     float desired_pellet_count(float density_target) const;
     float compute_cleanup_rate(std::size_t count, float desired) const;
@@ -365,6 +476,10 @@ private:
     bool is_circle_outside_dish(const EatableCircle& circle, float dish_radius) const;
     bool handle_outside_removal(const std::unique_ptr<EatableCircle>& circle, const SelectionManager::Snapshot& snapshot, float dish_radius, bool& selected_removed, bool& removed_creature);
 
+    std::uint32_t seed;
+    std::mt19937 rng;
+    // Installed as the world's user data; must outlive every shape.
+    CollisionFilter collision_filter;
     b2WorldId worldId;
     std::vector<std::unique_ptr<EatableCircle>> circles;
     SimulationTiming timing;
@@ -376,15 +491,24 @@ private:
     bool selection_dirty = true;
     DishSettings dish;
     PelletSettings pellets;
+    PelletGrid pellet_grid;
+    mutable RenderState render;
     MutationSettings mutation;
     MovementSettings movement;
     DeathSettings death;
     GenerationStats generation;
-    InnovationState innovation;
+    InnovationRegistry innovations;
+    InnovationCompaction innovation_compaction;
+    GenomePool genome_pool;
     AgeStats age;
+    AgeIndex age_index;
+    TelemetryState telemetry;
+    std::unique_ptr<event_trace::Recorder> event_recorder;
+    std::uint64_t next_entity_id = 1;
     ViewDragState view_drag;
     SelectionManager selection;
     Spawner spawner;
+    QosGovernor qos;
     PossesingSelectedCreature possesing;
     bool show_true_color = false;
     bool paused = false;
@@ -0,0 +1,169 @@
+#ifndef GAME_AGE_INDEX_HPP
+#define GAME_AGE_INDEX_HPP
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "game/order_statistic_treap.hpp"
+
+class CreatureCircle;
+
+// Binary min-heap over creatures that remembers each creature's slot, so a creature
+// whose key changed can be re-sifted or removed in O(log N). Before calls to update()
+// or erase(), the comparator must see only the one creature's key as changed.
+template <typename Compare>
+class IndexedHeap {
+public:
+    void push(const CreatureCircle* creature) {
+        if (slots.count(creature)) {
+            update(creature);
+            return;
+        }
+        heap.push_back(creature);
+        slots[creature] = heap.size() - 1;
+        sift_up(heap.size() - 1);
+    }
+
+    void erase(const CreatureCircle* creature) {
+        auto it = slots.find(creature);
+        if (it == slots.end()) {
+            return;
+        }
+        const std::size_t slot = it->second;
+        slots.erase(it);
+        const CreatureCircle* last = heap.back();
+        heap.pop_back();
+        if (slot < heap.size()) {
+            heap[slot] = last;
+            slots[last] = slot;
+            sift(slot);
+        }
+    }
+
+    void update(const CreatureCircle* creature) {
+        auto it = slots.find(creature);
+        if (it != slots.end()) {
+            sift(it->second);
+        }
+    }
+
+    const CreatureCircle* top() const { return heap.empty() ? nullptr : heap.front(); }
+    bool empty() const { return heap.empty(); }
+    std::size_t size() const { return heap.size(); }
+    void clear() {
+        heap.clear();
+        slots.clear();
+    }
+
+private:
+    void sift(std::size_t slot) {
+        if (slot > 0 && less(heap[slot], heap[(slot - 1) / 2])) {
+            sift_up(slot);
+        } else {
+            sift_down(slot);
+        }
+    }
+
+    void sift_up(std::size_t slot) {
+        while (slot > 0) {
+            const std::size_t parent = (slot - 1) / 2;
+            if (!less(heap[slot], heap[parent])) {
+                break;
+            }
+            swap_slots(slot, parent);
+            slot = parent;
+        }
+    }
+
+    void sift_down(std::size_t slot) {
+        for (;;) {
+            const std::size_t left = slot * 2 + 1;
+            const std::size_t right = left + 1;
+            std::size_t smallest = slot;
+            if (left < heap.size() && less(heap[left], heap[smallest])) {
+                smallest = left;
+            }
+            if (right < heap.size() && less(heap[right], heap[smallest])) {
+                smallest = right;
+            }
+            if (smallest == slot) {
+                return;
+            }
+            swap_slots(slot, smallest);
+            slot = smallest;
+        }
+    }
+
+    void swap_slots(std::size_t a, std::size_t b) {
+        std::swap(heap[a], heap[b]);
+        slots[heap[a]] = a;
+        slots[heap[b]] = b;
+    }
+
+    Compare less;
+    std::vector<const CreatureCircle*> heap;
+    std::unordered_map<const CreatureCircle*, std::size_t> slots;
+};
+
+// Keeps the living creatures ordered by age so longest-life stats and the
+// oldest-largest / oldest-median / oldest-smallest selection modes never rescan the dish.
+class AgeIndex {
+public:
+    void insert(const CreatureCircle& creature);
+    void erase(const CreatureCircle& creature);
+    // Call after a creature's creation or last division time changed.
+    void on_times_changed(const CreatureCircle& creature);
+    void on_area_changed(const CreatureCircle& creature);
+    void clear();
+
+    const CreatureCircle* oldest_largest() const { return by_age_largest.top(); }
+    const CreatureCircle* oldest_smallest() const { return by_age_smallest.top(); }
+    // Median by area among the creatures sharing the earliest creation time.
+    const CreatureCircle* oldest_median() const;
+    std::optional<float> min_creation_time() const;
+    std::optional<float> min_division_time() const;
+    std::size_t size() const { return by_division.size(); }
+
+private:
+    struct OldestThenLargest {
+        bool operator()(const CreatureCircle* a, const CreatureCircle* b) const;
+    };
+    struct OldestThenSmallest {
+        bool operator()(const CreatureCircle* a, const CreatureCircle* b) const;
+    };
+    struct EarliestDivision {
+        bool operator()(const CreatureCircle* a, const CreatureCircle* b) const;
+    };
+
+    using AreaKey = std::pair<float, const CreatureCircle*>;
+    struct AreaLess {
+        bool operator()(const AreaKey& a, const AreaKey& b) const {
+            if (a.first != b.first) {
+                return a.first < b.first;
+            }
+            return std::less<const CreatureCircle*>{}(a.second, b.second);
+        }
+    };
+    struct IndexedKey {
+        float creation_time;
+        float area;
+    };
+
+    void insert_by_area(const CreatureCircle& creature);
+    void erase_by_area(const CreatureCircle& creature);
+
+    IndexedHeap<OldestThenLargest> by_age_largest;
+    IndexedHeap<OldestThenSmallest> by_age_smallest;
+    IndexedHeap<EarliestDivision> by_division;
+    // Creation time -> areas of the creatures born then; begin() is the oldest bucket.
+    std::map<float, OrderStatisticTreap<AreaKey, AreaLess>> area_by_age;
+    // Keys as last indexed, since the treap needs the old key to find a moved creature.
+    std::unordered_map<const CreatureCircle*, IndexedKey> indexed_keys;
+};
+
+#endif
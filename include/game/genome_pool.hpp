@@ -0,0 +1,31 @@
+#ifndef GAME_GENOME_POOL_HPP
+#define GAME_GENOME_POOL_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <NEAT/genome.hpp>
+
+// Keeps the genomes of dead creatures around so new brains reuse their node and
+// connection buffers instead of going back to the heap on every division.
+class GenomePool {
+public:
+    explicit GenomePool(std::size_t max_pooled = 512) : max_pooled(max_pooled) {}
+
+    neat::Genome acquire_copy(const neat::Genome& source);
+    void release(neat::Genome&& genome);
+    void clear() { pooled.clear(); }
+    // Off while a dish tears down, so dying creatures don't refill a pool about to go.
+    void set_accepting(bool value) { accepting = value; }
+
+    std::size_t size() const { return pooled.size(); }
+    std::size_t get_reuse_count() const { return reuse_count; }
+
+private:
+    std::vector<neat::Genome> pooled;
+    std::size_t max_pooled;
+    std::size_t reuse_count = 0;
+    bool accepting = true;
+};
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef GAME_INNOVATION_REGISTRY_HPP
+#define GAME_INNOVATION_REGISTRY_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include <NEAT/genome.hpp>
+
+// Thread-safe (in node, out node) -> innovation id map shared by every genome in a dish.
+//
+// neat::Genome only knows how to talk to a raw vector-of-vectors table, so each
+// mutation runs against a thread-local scratch table primed from the genome, and
+// the genome's connection ids are then rewritten from the registry.
+class InnovationRegistry {
+public:
+    int lookup_or_assign(int in_node, int out_node);
+    void reconcile(neat::Genome& genome);
+
+    neat::Genome create_genome(int input_count, int output_count, float weight_extremum_init);
+
+    // fn(std::vector<std::vector<int>>* innovations, int* last_innovation_id) calls into neat::Genome.
+    template <typename Fn>
+    void mutate(neat::Genome& genome, Fn&& fn) {
+        std::lock_guard<std::mutex> lock(library_mutex());
+        ScratchTable& scratch = prepare_scratch(&genome);
+        // Ids the scratch table hands out start past this, so only new connections
+        // need a registry lookup; weight-only mutations skip it entirely.
+        const int placeholder_floor = scratch.last_id;
+        fn(&scratch.table, &scratch.last_id);
+        if (scratch.last_id > placeholder_floor) {
+            reconcile_new(genome, placeholder_floor);
+        }
+    }
+
+    // neat::Genome draws from one generator inside the library, so dishes on different
+    // DishPool workers must not create or mutate genomes at the same time.
+    static std::mutex& library_mutex();
+
+    // Drops node pairs no genome in live_genomes still uses and returns how many went.
+    // Ids are never reused, so a pair that reappears later simply gets a fresh one.
+    std::size_t compact(const std::vector<const neat::Genome*>& live_genomes);
+
+    int get_last_id() const { return last_innovation_id.load(std::memory_order_relaxed); }
+    std::size_t size() const;
+    std::size_t memory_bytes() const;
+
+private:
+    static constexpr std::size_t SHARD_COUNT = 16;
+    static constexpr std::uint64_t EMPTY_KEY = ~std::uint64_t{0};
+
+    struct Slot {
+        std::uint64_t key = EMPTY_KEY;
+        int id = 0;
+    };
+    // Open-addressing table with linear probing; capacity is always a power of two.
+    struct Shard {
+        mutable std::mutex mutex;
+        std::vector<Slot> slots;
+        std::size_t count = 0;
+
+        Slot* find_slot(std::uint64_t key, std::uint64_t hash);
+        void grow(std::size_t min_capacity);
+    };
+    struct ScratchTable {
+        std::vector<std::vector<int>> table;
+        int last_id = 0;
+    };
+
+    static std::uint64_t make_key(int in_node, int out_node);
+    static std::uint64_t hash_key(std::uint64_t key);
+    Shard& shard_for(std::uint64_t hash);
+    ScratchTable& prepare_scratch(const neat::Genome* genome);
+    void reconcile_new(neat::Genome& genome, int placeholder_floor);
+
+    std::array<Shard, SHARD_COUNT> shards;
+    std::atomic<int> last_innovation_id{0};
+};
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef GAME_LOD_RENDERER_HPP
+#define GAME_LOD_RENDERER_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+class DrawableCircle;
+
+// Picks a level of detail per circle from its on-screen radius: full shapes for large
+// circles, one batched low-segment mesh for small ones, and a CPU-rasterized density
+// texture for pellets smaller than a pixel. Circles are buffered between begin() and
+// finish(); finish() draws the density texture, then everything else (mesh, then full
+// shapes) followed by creatures the same way, so creatures always stay on top.
+class LodRenderer {
+public:
+    struct Stats {
+        std::size_t full = 0;
+        std::size_t low_detail = 0;
+        std::size_t density = 0;
+    };
+
+    void begin(const sf::RenderTarget& target);
+    void submit(const DrawableCircle& circle);
+    void finish(sf::RenderTarget& target);
+
+    const Stats& get_stats() const { return stats; }
+
+private:
+    struct DensityTexel {
+        float r = 0.0f;
+        float g = 0.0f;
+        float b = 0.0f;
+        float coverage = 0.0f;
+    };
+
+    // Creatures draw above everything else, whatever their size.
+    struct Layer {
+        std::vector<const DrawableCircle*> full_detail;
+        sf::VertexArray low_detail{sf::PrimitiveType::Triangles};
+    };
+
+    static void append_polygon(sf::VertexArray& mesh, sf::Vector2f center, float radius, sf::Color color, int segments);
+    static void append_heading(sf::VertexArray& mesh, sf::Vector2f center, float radius, float angle);
+    void splat_density(sf::Vector2f center, float radius, sf::Color color);
+    void upload_density();
+
+    Stats stats;
+    sf::FloatRect view_rect;
+    float pixels_per_unit = 1.0f;
+    bool density_enabled = false;
+
+    Layer background;
+    Layer creatures;
+
+    sf::Vector2u density_size{0, 0};
+    float texels_per_unit = 1.0f;
+    std::vector<DensityTexel> density;
+    std::vector<std::uint32_t> touched_texels;
+    std::vector<std::uint8_t> density_pixels;
+    sf::Texture density_texture;
+};
+
+#endif
@@ -0,0 +1,134 @@
+#ifndef GAME_ORDER_STATISTIC_TREAP_HPP
+#define GAME_ORDER_STATISTIC_TREAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// Treap with subtree sizes: insert, erase and k-th smallest in O(log N) expected.
+// Keys must be unique under Less. Nodes live in one vector and are recycled.
+template <typename Key, typename Less = std::less<Key>>
+class OrderStatisticTreap {
+public:
+    void insert(const Key& key) {
+        const int node = allocate(key);
+        auto [left, right] = split(root, key, /*equal_goes_left=*/false);
+        root = merge(merge(left, node), right);
+    }
+
+    bool erase(const Key& key) {
+        auto [left, rest] = split(root, key, /*equal_goes_left=*/false);
+        auto [match, right] = split(rest, key, /*equal_goes_left=*/true);
+        const bool found = match != NIL;
+        if (found) {
+            release(match);
+        }
+        root = merge(left, right);
+        return found;
+    }
+
+    // Zero-based rank in ascending order; nullptr when k is out of range.
+    const Key* kth(std::size_t k) const {
+        int node = root;
+        while (node != NIL) {
+            const std::size_t left_size = size_of(nodes[node].left);
+            if (k < left_size) {
+                node = nodes[node].left;
+            } else if (k == left_size) {
+                return &nodes[node].key;
+            } else {
+                k -= left_size + 1;
+                node = nodes[node].right;
+            }
+        }
+        return nullptr;
+    }
+
+    std::size_t size() const { return size_of(root); }
+    bool empty() const { return root == NIL; }
+
+private:
+    static constexpr int NIL = -1;
+
+    struct Node {
+        Key key;
+        std::uint32_t priority = 0;
+        int left = NIL;
+        int right = NIL;
+        std::size_t size = 1;
+    };
+
+    std::size_t size_of(int node) const { return node == NIL ? 0 : nodes[node].size; }
+
+    void refresh(int node) {
+        nodes[node].size = 1 + size_of(nodes[node].left) + size_of(nodes[node].right);
+    }
+
+    int allocate(const Key& key) {
+        // Deterministic priorities keep runs reproducible for a given seed.
+        std::uint64_t z = ++priority_counter * 0x9E3779B97F4A7C15ull;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        const auto priority = static_cast<std::uint32_t>(z ^ (z >> 31));
+        int node;
+        if (!free_nodes.empty()) {
+            node = free_nodes.back();
+            free_nodes.pop_back();
+            nodes[node] = Node{key, priority};
+        } else {
+            node = static_cast<int>(nodes.size());
+            nodes.push_back(Node{key, priority});
+        }
+        return node;
+    }
+
+    void release(int node) {
+        if (node == NIL) {
+            return;
+        }
+        release(nodes[node].left);
+        release(nodes[node].right);
+        free_nodes.push_back(node);
+    }
+
+    // Splits into (< key, >= key), or (<= key, > key) when equal_goes_left.
+    std::pair<int, int> split(int node, const Key& key, bool equal_goes_left) {
+        if (node == NIL) {
+            return {NIL, NIL};
+        }
+        const bool goes_left = equal_goes_left ? !less(key, nodes[node].key) : less(nodes[node].key, key);
+        if (goes_left) {
+            auto [left, right] = split(nodes[node].right, key, equal_goes_left);
+            nodes[node].right = left;
+            refresh(node);
+            return {node, right};
+        }
+        auto [left, right] = split(nodes[node].left, key, equal_goes_left);
+        nodes[node].left = right;
+        refresh(node);
+        return {left, node};
+    }
+
+    int merge(int left, int right) {
+        if (left == NIL) return right;
+        if (right == NIL) return left;
+        if (nodes[left].priority > nodes[right].priority) {
+            nodes[left].right = merge(nodes[left].right, right);
+            refresh(left);
+            return left;
+        }
+        nodes[right].left = merge(left, nodes[right].left);
+        refresh(right);
+        return right;
+    }
+
+    Less less;
+    std::vector<Node> nodes;
+    std::vector<int> free_nodes;
+    std::uint64_t priority_counter = 0;
+    int root = NIL;
+};
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef GAME_PELLET_GRID_HPP
+#define GAME_PELLET_GRID_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <box2d/box2d.h>
+
+class EatableCircle;
+
+// Packed uniform grid over bodyless pellets. Rebuilt once per tick and queried by
+// creatures in place of Box2D sensor pairs.
+class PelletGrid {
+public:
+    void rebuild(const std::vector<std::unique_ptr<EatableCircle>>& circles);
+
+    // Calls fn(EatableCircle&) for every pellet whose disc overlaps the query disc.
+    template <typename Fn>
+    void for_each_overlapping(const b2Vec2& center, float radius, Fn&& fn) const {
+        if (entries.empty()) {
+            return;
+        }
+        const float reach = radius + max_radius;
+        const int x0 = std::max(cell_coord_x(center.x - reach), 0);
+        const int x1 = std::min(cell_coord_x(center.x + reach), columns - 1);
+        const int y0 = std::max(cell_coord_y(center.y - reach), 0);
+        const int y1 = std::min(cell_coord_y(center.y + reach), rows - 1);
+        for (int cy = y0; cy <= y1; ++cy) {
+            for (int cx = x0; cx <= x1; ++cx) {
+                const std::size_t cell = static_cast<std::size_t>(cy) * static_cast<std::size_t>(columns) + static_cast<std::size_t>(cx);
+                for (std::uint32_t i = cell_start[cell]; i < cell_start[cell + 1]; ++i) {
+                    const Entry& e = entries[i];
+                    const float dx = e.x - center.x;
+                    const float dy = e.y - center.y;
+                    const float r = radius + e.radius;
+                    if (dx * dx + dy * dy < r * r) {
+                        fn(*e.circle);
+                    }
+                }
+            }
+        }
+    }
+
+    std::size_t size() const { return entries.size(); }
+
+private:
+    struct Entry {
+        float x;
+        float y;
+        float radius;
+        EatableCircle* circle;
+    };
+
+    int cell_coord_x(float x) const { return static_cast<int>((x - origin_x) * inverse_cell_size); }
+    int cell_coord_y(float y) const { return static_cast<int>((y - origin_y) * inverse_cell_size); }
+
+    std::vector<Entry> entries;
+    std::vector<Entry> scratch;
+    std::vector<std::uint32_t> cell_start;
+    std::vector<std::uint32_t> entry_cells;
+    std::vector<std::uint32_t> cell_fill;
+    float origin_x = 0.0f;
+    float origin_y = 0.0f;
+    float inverse_cell_size = 1.0f;
+    float max_radius = 0.0f;
+    int columns = 0;
+    int rows = 0;
+};
+
+#endif
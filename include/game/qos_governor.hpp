@@ -0,0 +1,72 @@
+#ifndef GAME_QOS_GOVERNOR_HPP
+#define GAME_QOS_GOVERNOR_HPP
+
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <vector>
+
+class Game;
+
+// Holds a dish near a target sim speed under load by stepping through degradation
+// levels: first the brain update rate drops, then pellet sprinkle rates, then a soft
+// cap stops divisions. Levels are restored in reverse once ticks are cheap again.
+// The dish's own settings are never rewritten; the governor only scales them where
+// they are read, so edits made while degraded survive. Every level change is logged.
+class QosGovernor {
+public:
+    struct Settings {
+        bool enabled = false;
+        // Sim seconds per wall second to hold; 0 follows the dish's requested time scale.
+        float target_speed = 0.0f;
+        float min_brain_hz = 2.0f;
+    };
+
+    explicit QosGovernor(Game& game_ref);
+
+    void set_enabled(bool enabled);
+    Settings& get_settings() { return settings; }
+    const Settings& get_settings() const { return settings; }
+
+    // Called by the dish after every tick with the wall time the tick took.
+    void record_tick(float wall_seconds, float sim_seconds);
+
+    // What the dish should actually run at, given the rate its settings ask for.
+    float governed_brain_hz(float requested) const;
+    float governed_sprinkle_rate(float requested) const { return requested * sprinkle_scale; }
+
+    // Divisions are refused while the population is at the soft cap.
+    bool allows_new_creature(std::size_t creature_count) const {
+        return soft_cap == 0 || creature_count < soft_cap;
+    }
+
+    int get_level() const { return level; }
+    std::size_t get_soft_cap() const { return soft_cap; }
+    float get_last_tick_cost() const { return last_tick_cost; }
+    float get_tick_budget() const { return last_budget; }
+    const std::deque<std::string>& get_history() const { return history; }
+    // Adjustments since the last call, for the caller to print.
+    std::vector<std::string> take_pending_log();
+
+private:
+    void evaluate();
+    void change_level(int new_level, float tick_cost, float budget);
+    void apply_level();
+
+    Game& game;
+    Settings settings;
+    int level = 0;
+    float brain_scale = 1.0f;
+    float sprinkle_scale = 1.0f;
+    std::size_t soft_cap = 0;
+    std::size_t cap_anchor = 0;
+    float window_cost = 0.0f;
+    float window_sim = 0.0f;
+    int window_ticks = 0;
+    float last_tick_cost = 0.0f;
+    float last_budget = 0.0f;
+    std::deque<std::string> history;
+    std::vector<std::string> pending_log;
+};
+
+#endif
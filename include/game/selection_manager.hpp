@@ -8,6 +8,7 @@
 #include <SFML/Graphics/View.hpp>
 #include <box2d/box2d.h>
 
+class AgeIndex;
 class EatableCircle;
 class CreatureCircle;
 namespace neat { class Genome; }
@@ -20,7 +21,7 @@ public:
         b2Vec2 position{0.0f, 0.0f};
     };
 
-    SelectionManager(std::vector<std::unique_ptr<EatableCircle>>& circles, float& sim_time_accum);
+    SelectionManager(std::vector<std::unique_ptr<EatableCircle>>& circles, float& sim_time_accum, const AgeIndex& ages);
 
     void clear();
     bool select_circle_at_world(const b2Vec2& pos);
@@ -28,9 +29,7 @@ public:
     const CreatureCircle* get_selected_creature() const;
     const CreatureCircle* get_oldest_largest_creature() const;
     const CreatureCircle* get_oldest_smallest_creature() const;
-#ifndef NDEBUG
     const CreatureCircle* get_oldest_middle_creature() const;
-#endif
     const CreatureCircle* get_follow_target_creature() const;
     int get_selected_generation() const;
     void update_follow_view(sf::View& view) const;
@@ -46,6 +45,7 @@ public:
 private:
     std::vector<std::unique_ptr<EatableCircle>>* circles;
     float* sim_time;
+    const AgeIndex* ages;
     std::optional<std::size_t> selected_index;
     bool follow_selected = false;
 };
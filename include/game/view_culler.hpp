@@ -0,0 +1,46 @@
+#ifndef GAME_VIEW_CULLER_HPP
+#define GAME_VIEW_CULLER_HPP
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <SFML/Graphics/Rect.hpp>
+
+class EatableCircle;
+
+// Packed uniform grid over every circle's center, rebuilt per frame and queried with
+// the view rectangle so off-screen circles are never submitted for drawing.
+class ViewCuller {
+public:
+    void rebuild(const std::vector<std::unique_ptr<EatableCircle>>& circles);
+
+    // Fills out with the indices (into the circles vector passed to rebuild) of every
+    // circle whose bounding box intersects rect, in ascending order so draw order holds.
+    void query(const sf::FloatRect& rect, std::vector<std::uint32_t>& out) const;
+
+private:
+    struct Entry {
+        float x;
+        float y;
+        float radius;
+        std::uint32_t index;
+    };
+
+    int cell_coord_x(float x) const { return static_cast<int>((x - origin_x) * inverse_cell_size); }
+    int cell_coord_y(float y) const { return static_cast<int>((y - origin_y) * inverse_cell_size); }
+
+    std::vector<Entry> entries;
+    std::vector<Entry> scratch;
+    std::vector<std::uint32_t> cell_start;
+    std::vector<std::uint32_t> entry_cells;
+    std::vector<std::uint32_t> cell_fill;
+    float origin_x = 0.0f;
+    float origin_y = 0.0f;
+    float inverse_cell_size = 1.0f;
+    float max_radius = 0.0f;
+    int columns = 0;
+    int rows = 0;
+};
+
+#endif
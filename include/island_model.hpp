@@ -0,0 +1,58 @@
+#ifndef ISLAND_MODEL_HPP
+#define ISLAND_MODEL_HPP
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "dish_pool.hpp"
+#include "game.hpp"
+
+// Per-dish inboxes that dishes post migrants into while running on different threads.
+class MigrationChannel {
+public:
+    explicit MigrationChannel(std::size_t dish_count);
+
+    void send(std::size_t to_dish, std::vector<Game::Migrant> migrants);
+    std::vector<Game::Migrant> receive(std::size_t dish);
+
+private:
+    struct Inbox {
+        std::mutex mutex;
+        std::vector<Game::Migrant> migrants;
+    };
+    std::vector<std::unique_ptr<Inbox>> inboxes;
+};
+
+// Island-model evolution over a DishPool: every interval the top creatures of
+// each dish migrate to the next dish in a ring.
+class IslandModel {
+public:
+    struct Settings {
+        bool enabled = false;
+        float interval = 60.0f;
+        int migrants_per_exchange = 2;
+        Game::MigrantRank rank = Game::MigrantRank::Oldest;
+    };
+
+    explicit IslandModel(DishPool& pool);
+
+    // Call after each pool step; migrates once every dish has passed the next exchange time.
+    void update();
+    void migrate_now();
+
+    Settings& get_settings() { return settings; }
+    int get_exchange_count() const { return exchange_count; }
+    float get_next_exchange_time() const { return next_exchange_time; }
+
+private:
+    float slowest_sim_time() const;
+
+    DishPool& pool;
+    MigrationChannel channel;
+    Settings settings;
+    float next_exchange_time = 0.0f;
+    int exchange_count = 0;
+};
+
+#endif
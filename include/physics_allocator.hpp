@@ -0,0 +1,39 @@
+#ifndef PHYSICS_ALLOCATOR_HPP
+#define PHYSICS_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// Backs every Box2D allocation with one reserved arena (huge pages where the OS
+// allows) and counts the bytes. Blocks are rounded to power-of-two size classes and
+// recycled through per-class free lists, so live block bytes can exceed what Box2D
+// asked for by up to 2x; both figures are reported. Anything that does not fit the
+// arena goes to the regular heap and is still counted. The numbers cover all dishes
+// in the process.
+namespace physics_allocator {
+
+constexpr std::size_t DEFAULT_ARENA_MIB = 1024;
+
+struct Stats {
+    // Bytes Box2D asked for and has not freed yet.
+    std::size_t requested_bytes = 0;
+    // Live block bytes, including size-class rounding; this is what the arena holds.
+    std::size_t current_bytes = 0;
+    std::size_t peak_bytes = 0;
+    // Arena address space carved into blocks so far, including size-class rounding.
+    std::size_t arena_used_bytes = 0;
+    std::size_t arena_reserved_bytes = 0;
+    std::size_t heap_bytes = 0;
+    std::uint64_t allocations = 0;
+    bool huge_pages = false;
+};
+
+// Installs the Box2D allocator hooks. Must run before the first world is created;
+// an arena of 0 bytes only counts allocations. Later calls are ignored.
+void install(std::size_t arena_bytes);
+bool is_installed();
+Stats get_stats();
+
+} // namespace physics_allocator
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef SWEEP_HPP
+#define SWEEP_HPP
+
+#include <string>
+#include <utility>
+#include <vector>
+
+class Game;
+
+// One swept setting, parsed from "name=v1,v2,...".
+struct SweepAxis {
+    std::string name;
+    std::vector<float> values;
+};
+
+using SweepPoint = std::vector<std::pair<std::string, float>>;
+
+bool parse_sweep_axis(const std::string& text, SweepAxis& out, std::string& error);
+// Cartesian product of all axes; a single empty point when there are none.
+std::vector<SweepPoint> expand_sweep(const std::vector<SweepAxis>& axes);
+bool apply_sweep_point(Game& game, const SweepPoint& point);
+std::string sweep_setting_names();
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef TELEMETRY_HPP
+#define TELEMETRY_HPP
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Append-only columnar log of per-interval population aggregates.
+//
+// Layout (little-endian):
+//   header: "PDTL" u32 version, u32 column count, then per column: u8 type, u16 name length, name bytes
+//   chunks: "CHNK" u32 row count, then each column's values back to back (4 bytes per value)
+// A chunk is only written whole, so a run that dies mid-write loses at most the unflushed rows.
+namespace telemetry {
+
+constexpr std::uint32_t FORMAT_VERSION = 1;
+constexpr std::size_t GENERATION_BUCKETS = 8;
+
+enum class ColumnType : std::uint8_t {
+    U32 = 0,
+    F32 = 1
+};
+
+struct Record {
+    float sim_time = 0.0f;
+    float wall_seconds = 0.0f;
+    float sim_speed = 0.0f;
+    std::uint32_t creatures = 0;
+    std::uint32_t food_pellets = 0;
+    std::uint32_t toxic_pellets = 0;
+    std::uint32_t division_pellets = 0;
+    std::uint32_t boost_particles = 0;
+    // Births are division children; arrivals are creatures spawned or migrated in.
+    std::uint32_t births = 0;
+    std::uint32_t arrivals = 0;
+    std::uint32_t deaths = 0;
+    std::uint32_t max_generation = 0;
+    // Bucket 0 holds generation 0, bucket i holds [2^(i-1), 2^i), the last bucket everything above.
+    std::array<std::uint32_t, GENERATION_BUCKETS> generation_histogram{};
+    float area_min = 0.0f;
+    float area_p25 = 0.0f;
+    float area_median = 0.0f;
+    float area_p75 = 0.0f;
+    float area_max = 0.0f;
+    float area_mean = 0.0f;
+    float brain_nodes_mean = 0.0f;
+    std::uint32_t brain_nodes_max = 0;
+    float brain_connections_mean = 0.0f;
+    std::uint32_t brain_connections_max = 0;
+    // Box2D memory of the whole process, not just this dish.
+    std::uint32_t physics_kib = 0;
+    std::uint32_t physics_peak_kib = 0;
+};
+
+std::size_t generation_bucket(int generation);
+
+struct Column {
+    std::string name;
+    ColumnType type = ColumnType::F32;
+};
+
+class Writer {
+public:
+    explicit Writer(std::size_t rows_per_chunk = 64) : rows_per_chunk(rows_per_chunk) {}
+    ~Writer();
+
+    bool open(const std::string& path);
+    void append(const Record& record);
+    void flush();
+    void close();
+    bool is_open() const { return out.is_open(); }
+
+private:
+    std::ofstream out;
+    std::vector<std::vector<std::uint32_t>> columns;
+    std::size_t rows_per_chunk;
+    std::size_t buffered_rows = 0;
+};
+
+// Reads any file in this format, independent of the columns the writer currently emits.
+class Reader {
+public:
+    bool open(const std::string& path, std::string& error);
+    const std::vector<Column>& get_columns() const { return columns; }
+    // Fills values[column][row] with the next chunk; returns false at end of file.
+    bool next_chunk(std::vector<std::vector<double>>& values);
+
+private:
+    std::ifstream in;
+    std::vector<Column> columns;
+};
+
+} // namespace telemetry
+
+#endif
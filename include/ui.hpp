@@ -2,6 +2,9 @@
 
 #include <SFML/Graphics.hpp>
 
+#include "dish_pool.hpp"
 #include "game.hpp"
+#include "island_model.hpp"
 
 void render_ui(sf::RenderWindow& window, sf::View& view, Game& game);
+void render_dish_picker(DishPool& pool, IslandModel& islands, std::size_t& active_dish);
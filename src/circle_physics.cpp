@@ -1,11 +1,24 @@
 #include "circle_physics.hpp"
+#include "collision_filter.hpp"
 
 #include <algorithm>
 #include <cmath>
 
+namespace {
+// Well above the resting drift of a damped pellet, so Sleeping bodies drop out of
+// the solver almost as soon as they settle.
+constexpr float SLEEPING_BODY_THRESHOLD = 0.5f;
+constexpr float REST_VELOCITY_EPSILON = 1e-3f;
+
+b2BodyType body_type_for(CirclePhysics::BodyMotion motion) {
+    return motion == CirclePhysics::BodyMotion::Static ? b2_staticBody : b2_dynamicBody;
+}
+} // namespace
 
 CirclePhysics::CirclePhysics(const b2WorldId &worldId, Config config) :
     bodyId{},
+    ownerWorldId(worldId),
+    detachedState{},
     density(config.density),
     isSensor(true),
     enableSensorEvents(true),
@@ -22,7 +35,11 @@ CirclePhysics::CirclePhysics(const b2WorldId &worldId, Config config) :
     initialState.radius = config.radius;
 
     set_cached_radius(config.radius);
-    createBodyWithState(worldId, initialState);
+    if (config.with_body) {
+        createBodyWithState(worldId, initialState);
+    } else {
+        detachedState = initialState;
+    }
 }
 
 CirclePhysics::~CirclePhysics() {
@@ -36,10 +53,16 @@ CirclePhysics::~CirclePhysics() {
 }
 
 CirclePhysics::BodyState CirclePhysics::captureBodyState() const {
+    if (!has_body()) {
+        BodyState state = detachedState;
+        state.radius = getRadius();
+        return state;
+    }
+    const MotionCache& cached = motion();
     BodyState state{};
-    state.position = b2Body_GetPosition(bodyId);
-    state.rotation = b2Body_GetRotation(bodyId);
-    state.linearVelocity = b2Body_GetLinearVelocity(bodyId);
+    state.position = cached.position;
+    state.rotation = cached.rotation;
+    state.linearVelocity = cached.linearVelocity;
     state.angularVelocity = b2Body_GetAngularVelocity(bodyId);
     state.radius = getRadius();
     return state;
@@ -47,13 +70,18 @@ CirclePhysics::BodyState CirclePhysics::captureBodyState() const {
 
 b2BodyDef CirclePhysics::buildBodyDef(const BodyState& state) const {
     b2BodyDef bodyDef = b2DefaultBodyDef();
-    bodyDef.type = b2_dynamicBody;
+    bodyDef.type = body_type_for(bodyMotion);
+    if (bodyMotion == BodyMotion::Sleeping) {
+        bodyDef.enableSleep = true;
+        bodyDef.sleepThreshold = SLEEPING_BODY_THRESHOLD;
+    }
     bodyDef.position = state.position;
     bodyDef.rotation = state.rotation;
     bodyDef.linearVelocity = state.linearVelocity;
     bodyDef.angularVelocity = state.angularVelocity;
     bodyDef.linearDamping = linearDamping;
     bodyDef.angularDamping = angularDamping;
+    bodyDef.userData = const_cast<CirclePhysics*>(this);
     return bodyDef;
 }
 
@@ -63,9 +91,23 @@ b2ShapeDef CirclePhysics::buildCircleShapeDef() const {
     shapeDef.userData = const_cast<CirclePhysics*>(this);
     shapeDef.isSensor = isSensor;
     shapeDef.enableSensorEvents = enableSensorEvents;
+    shapeDef.filter = CollisionFilter::for_world(ownerWorldId).filter_for(kind);
     return shapeDef;
 }
 
+void CirclePhysics::refresh_collision_filter() {
+    if (!has_body()) return;
+    b2ShapeId shapeId;
+    b2Body_GetShapes(bodyId, &shapeId, 1);
+    b2Shape_SetFilter(shapeId, CollisionFilter::for_world(ownerWorldId).filter_for(kind));
+}
+
+void CirclePhysics::set_kind(CircleKind k) {
+    if (kind == k) return;
+    kind = k;
+    refresh_collision_filter();
+}
+
 void CirclePhysics::createBodyWithState(const b2WorldId& worldId, const BodyState& state) {
     set_cached_radius(state.radius);
 
@@ -78,6 +120,64 @@ void CirclePhysics::createBodyWithState(const b2WorldId& worldId, const BodyStat
     circle.radius = state.radius;
 
     b2CreateCircleShape(bodyId, &shapeDef, &circle);
+
+    motionCache.position = state.position;
+    motionCache.rotation = state.rotation;
+    motionCache.linearVelocity = state.linearVelocity;
+    motionCache.valid = true;
+}
+
+void CirclePhysics::ensure_body() {
+    if (has_body()) return;
+    createBodyWithState(ownerWorldId, captureBodyState());
+}
+
+void CirclePhysics::release_body() {
+    if (!has_body()) return;
+    detachedState = captureBodyState();
+    detachedState.linearVelocity = b2Vec2{0.0f, 0.0f};
+    detachedState.angularVelocity = 0.0f;
+    b2DestroyBody(bodyId);
+    bodyId = b2BodyId{};
+}
+
+void CirclePhysics::prepare_for_push() {
+    ensure_body();
+    if (b2Body_GetType(bodyId) != b2_dynamicBody) {
+        b2Body_SetType(bodyId, b2_dynamicBody);
+        invalidate_motion();
+    }
+}
+
+void CirclePhysics::set_body_motion(BodyMotion motion) {
+    bodyMotion = motion;
+    if (!has_body()) return;
+
+    b2Body_SetSleepThreshold(bodyId, motion == BodyMotion::Sleeping ? SLEEPING_BODY_THRESHOLD : b2DefaultBodyDef().sleepThreshold);
+    b2Body_SetType(bodyId, body_type_for(motion));
+    invalidate_motion();
+}
+
+bool CirclePhysics::is_at_rest() const {
+    b2Vec2 v = getLinearVelocity();
+    return std::fabs(v.x) <= REST_VELOCITY_EPSILON && std::fabs(v.y) <= REST_VELOCITY_EPSILON;
+}
+
+void CirclePhysics::restore_body_motion() {
+    if (!has_body() || bodyMotion != BodyMotion::Static) return;
+    if (b2Body_GetType(bodyId) != b2_staticBody && is_at_rest()) {
+        b2Body_SetType(bodyId, b2_staticBody);
+        invalidate_motion();
+    }
+}
+
+void CirclePhysics::clear_touching() {
+    auto previously_touching = std::move(touching_circles);
+    touching_circles.clear();
+    for (auto* touching_circle : previously_touching) {
+        touching_circle->remove_touching_circle(this);
+        on_touching_removed(touching_circle);
+    }
 }
 
 void CirclePhysics::recreateBodyWithState(const b2WorldId& worldId, const BodyState& state) {
@@ -89,6 +189,10 @@ void CirclePhysics::recreateBodyWithState(const b2WorldId& worldId, const BodySt
 
 CirclePhysics::CirclePhysics(CirclePhysics&& other_circle_physics) noexcept :
     bodyId(other_circle_physics.bodyId),
+    ownerWorldId(other_circle_physics.ownerWorldId),
+    detachedState(other_circle_physics.detachedState),
+    motionCache(other_circle_physics.motionCache),
+    bodyMotion(other_circle_physics.bodyMotion),
     density(other_circle_physics.density),
     isSensor(other_circle_physics.isSensor),
     enableSensorEvents(other_circle_physics.enableSensorEvents),
@@ -100,9 +204,12 @@ CirclePhysics::CirclePhysics(CirclePhysics&& other_circle_physics) noexcept :
     kind(other_circle_physics.kind),
     touching_circles(std::move(other_circle_physics.touching_circles)) {
 
-    b2ShapeId shapeId;
-    b2Body_GetShapes(bodyId, &shapeId, 1);
-    b2Shape_SetUserData(shapeId, this);
+    if (has_body()) {
+        b2Body_SetUserData(bodyId, this);
+        b2ShapeId shapeId;
+        b2Body_GetShapes(bodyId, &shapeId, 1);
+        b2Shape_SetUserData(shapeId, this);
+    }
 
     other_circle_physics.bodyId = b2BodyId{};
     other_circle_physics.kind = CircleKind::Unknown;
@@ -120,6 +227,10 @@ CirclePhysics& CirclePhysics::operator=(CirclePhysics&& other_circle_physics) no
 
     if (b2Body_IsValid(bodyId)) b2DestroyBody(bodyId);
     bodyId = other_circle_physics.bodyId;
+    ownerWorldId = other_circle_physics.ownerWorldId;
+    detachedState = other_circle_physics.detachedState;
+    motionCache = other_circle_physics.motionCache;
+    bodyMotion = other_circle_physics.bodyMotion;
     density = other_circle_physics.density;
     isSensor = other_circle_physics.isSensor;
     enableSensorEvents = other_circle_physics.enableSensorEvents;
@@ -130,9 +241,12 @@ CirclePhysics& CirclePhysics::operator=(CirclePhysics&& other_circle_physics) no
     radius_cached = other_circle_physics.radius_cached;
     kind = other_circle_physics.kind;
 
-    b2ShapeId shapeId;
-    b2Body_GetShapes(bodyId, &shapeId, 1);
-    b2Shape_SetUserData(shapeId, this);
+    if (has_body()) {
+        b2Body_SetUserData(bodyId, this);
+        b2ShapeId shapeId;
+        b2Body_GetShapes(bodyId, &shapeId, 1);
+        b2Shape_SetUserData(shapeId, this);
+    }
 
     other_circle_physics.bodyId = b2BodyId{};
     other_circle_physics.kind = CircleKind::Unknown;
@@ -146,12 +260,31 @@ CirclePhysics& CirclePhysics::operator=(CirclePhysics&& other_circle_physics) no
     return *this;
 }
 
+const CirclePhysics::MotionCache& CirclePhysics::motion() const {
+    if (!motionCache.valid) {
+        motionCache.position = b2Body_GetPosition(bodyId);
+        motionCache.rotation = b2Body_GetRotation(bodyId);
+        motionCache.linearVelocity = b2Body_GetLinearVelocity(bodyId);
+        motionCache.valid = true;
+    }
+    return motionCache;
+}
+
+void CirclePhysics::sync_from_move_event(const b2BodyMoveEvent& event) {
+    motionCache.position = event.transform.p;
+    motionCache.rotation = event.transform.q;
+    motionCache.linearVelocity = event.fellAsleep ? b2Vec2{0.0f, 0.0f} : b2Body_GetLinearVelocity(bodyId);
+    motionCache.valid = true;
+}
+
 b2Vec2 CirclePhysics::getPosition() const {
-    return b2Body_GetPosition(bodyId);
+    if (!has_body()) return detachedState.position;
+    return motion().position;
 }
 
 b2Vec2 CirclePhysics::getLinearVelocity() const {
-    return b2Body_GetLinearVelocity(bodyId);
+    if (!has_body()) return detachedState.linearVelocity;
+    return motion().linearVelocity;
 }
 
 float CirclePhysics::getRadius() const {
@@ -171,84 +304,88 @@ void CirclePhysics::grow_by_area(float delta_area, const b2WorldId& worldId) {
     setArea(new_area, worldId);
 }
 
-void CirclePhysics::apply_forward_force() const {
-    b2Rot rotation = b2Body_GetRotation(bodyId);
+void CirclePhysics::apply_forward_force() {
+    prepare_for_push();
+    b2Rot rotation = motion().rotation;
     float force_magnitude = 50.0f;
     b2Vec2 force = {force_magnitude * rotation.c, force_magnitude * rotation.s};
     b2Body_ApplyForceToCenter(bodyId, force, true);
 };
 
 void CirclePhysics::apply_zero_force() const {
+    if (!has_body()) return;
     b2Vec2 force = {0.0f, 0.0f};
     b2Body_ApplyForceToCenter(bodyId, force, true);
 };
 
-void CirclePhysics::apply_left_turn_torque() const {
+void CirclePhysics::apply_left_turn_torque() {
+    prepare_for_push();
     b2Body_ApplyTorque(bodyId, -50.0f, true);
 };
 
-void CirclePhysics::apply_right_turn_torque() const {
+void CirclePhysics::apply_right_turn_torque() {
+    prepare_for_push();
     b2Body_ApplyTorque(bodyId, 50.0f, true);
 };
 
 void CirclePhysics::apply_zero_torque() const {
+    if (!has_body()) return;
     b2Body_ApplyTorque(bodyId, 0.0f, true);
 };
 
-void CirclePhysics::apply_forward_impulse() const {
-    b2Rot rotation = b2Body_GetRotation(bodyId);
-    b2Vec2 impulse = {linearImpulseMagnitude * rotation.c, linearImpulseMagnitude * rotation.s};
-    b2Body_ApplyLinearImpulse(bodyId, impulse, b2Body_GetPosition(bodyId), true);
+void CirclePhysics::apply_forward_impulse() {
+    prepare_for_push();
+    const MotionCache& cached = motion();
+    b2Vec2 impulse = {linearImpulseMagnitude * cached.rotation.c, linearImpulseMagnitude * cached.rotation.s};
+    b2Body_ApplyLinearImpulse(bodyId, impulse, cached.position, true);
+    invalidate_motion();
 };
 
-void CirclePhysics::apply_forward_impulse_at_point(const b2Vec2& world_point) const {
-    b2Rot rotation = b2Body_GetRotation(bodyId);
+void CirclePhysics::apply_forward_impulse_at_point(const b2Vec2& world_point) {
+    prepare_for_push();
+    b2Rot rotation = motion().rotation;
     b2Vec2 impulse = {linearImpulseMagnitude * rotation.c, linearImpulseMagnitude * rotation.s};
     b2Body_ApplyLinearImpulse(bodyId, impulse, world_point, true);
+    invalidate_motion();
 };
 
-void CirclePhysics::apply_left_turn_impulse() const {
+void CirclePhysics::apply_left_turn_impulse() {
+    prepare_for_push();
     b2Body_ApplyAngularImpulse(bodyId, -angularImpulseMagnitude, true);
+    invalidate_motion();
 };
 
-void CirclePhysics::apply_right_turn_impulse() const {
+void CirclePhysics::apply_right_turn_impulse() {
+    prepare_for_push();
     b2Body_ApplyAngularImpulse(bodyId, angularImpulseMagnitude, true);
+    invalidate_motion();
 };
 
 float CirclePhysics::getAngle() const {
-    return b2Rot_GetAngle(b2Body_GetRotation(bodyId));
+    if (!has_body()) return b2Rot_GetAngle(detachedState.rotation);
+    return b2Rot_GetAngle(motion().rotation);
 }
 
 void CirclePhysics::add_touching_circle(CirclePhysics* circle_physics) {
-    touching_circles.insert(circle_physics);
-}
-
-void CirclePhysics::remove_touching_circle(CirclePhysics* circle_physics) {
-    touching_circles.erase(circle_physics);
-}
-
-void CirclePhysics::for_each_touching(const std::function<void(CirclePhysics&)>& fn) {
-    for (auto* c : touching_circles) {
-        if (c) {
-            fn(*c);
-        }
+    if (touching_circles.insert(circle_physics).second) {
+        on_touching_added(circle_physics);
     }
 }
 
-void CirclePhysics::for_each_touching(const std::function<void(const CirclePhysics&)>& fn) const {
-    for (auto* c : touching_circles) {
-        if (c) {
-            fn(*c);
-        }
+void CirclePhysics::remove_touching_circle(CirclePhysics* circle_physics) {
+    if (touching_circles.erase(circle_physics) > 0) {
+        on_touching_removed(circle_physics);
     }
 }
 
 void CirclePhysics::setRadius(float new_radius, const b2WorldId &worldId) {
     (void)worldId;
     if (new_radius <= 0.0f) return;
-    if (!b2Body_IsValid(bodyId)) return;
-
     set_cached_radius(new_radius);
+    on_radius_changed();
+    if (!has_body()) {
+        return;
+    }
 
     b2ShapeId shapeId;
     b2Body_GetShapes(bodyId, &shapeId, 1);
@@ -270,18 +407,26 @@ void CirclePhysics::setArea(float area, const b2WorldId &worldId) {
 
 void CirclePhysics::setPosition(const b2Vec2& new_position, const b2WorldId &worldId) {
     (void)worldId;
-    if (!b2Body_IsValid(bodyId)) return;
+    if (!has_body()) {
+        detachedState.position = new_position;
+        return;
+    }
 
-    b2Rot currentRot = b2Body_GetRotation(bodyId);
+    b2Rot currentRot = motion().rotation;
     b2Body_SetTransform(bodyId, new_position, currentRot);
+    motionCache.position = new_position;
 }
 
 void CirclePhysics::setAngle(float new_angle, const b2WorldId &worldId) {
     (void)worldId;
-    if (!b2Body_IsValid(bodyId)) return;
+    if (!has_body()) {
+        detachedState.rotation = b2MakeRot(new_angle);
+        return;
+    }
 
-    b2Vec2 currentPos = b2Body_GetPosition(bodyId);
+    b2Vec2 currentPos = motion().position;
     b2Body_SetTransform(bodyId, currentPos, b2MakeRot(new_angle));
+    motionCache.rotation = b2MakeRot(new_angle);
 }
 
 void CirclePhysics::set_density(float new_density, const b2WorldId& worldId) {
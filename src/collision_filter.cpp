@@ -0,0 +1,38 @@
+#include "collision_filter.hpp"
+
+CollisionFilter::CollisionFilter() {
+    for (std::size_t i = 0; i < KIND_COUNT; ++i) {
+        set_pair(CircleKind::Creature, static_cast<CircleKind>(i), true);
+    }
+}
+
+void CollisionFilter::set_pair(CircleKind a, CircleKind b, bool enabled) {
+    auto& mask_a = masks[static_cast<std::size_t>(a)];
+    auto& mask_b = masks[static_cast<std::size_t>(b)];
+    if (enabled) {
+        mask_a |= category_bit(b);
+        mask_b |= category_bit(a);
+    } else {
+        mask_a &= ~category_bit(b);
+        mask_b &= ~category_bit(a);
+    }
+}
+
+bool CollisionFilter::get_pair(CircleKind a, CircleKind b) const {
+    return (masks[static_cast<std::size_t>(a)] & category_bit(b)) != 0;
+}
+
+b2Filter CollisionFilter::filter_for(CircleKind kind) const {
+    b2Filter filter = b2DefaultFilter();
+    filter.categoryBits = category_bit(kind);
+    filter.maskBits = masks[static_cast<std::size_t>(kind)];
+    return filter;
+}
+
+const CollisionFilter& CollisionFilter::for_world(b2WorldId world) {
+    static const CollisionFilter default_filter;
+    if (const auto* installed = static_cast<const CollisionFilter*>(b2World_GetUserData(world))) {
+        return *installed;
+    }
+    return default_filter;
+}
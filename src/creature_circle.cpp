@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 
 #include <cstdlib>
 #include <vector>
@@ -14,6 +15,8 @@ constexpr int SENSOR_COUNT = kColorSensorCount;
 static_assert(SENSOR_COUNT >= kMinColorSensorCount && SENSOR_COUNT <= kMaxColorSensorCount, "Color sensor count out of supported range.");
 constexpr float SECTOR_WIDTH = TWO_PI / static_cast<float>(SENSOR_COUNT);
 constexpr float SECTOR_HALF = SECTOR_WIDTH * 0.5f;
+// Slightly below the exact 0.4919 depth at which a chord leaves 20% of a circle outside.
+constexpr float EAT_MIN_DEPTH_FRACTION = 0.49f;
 
 using SectorSegment = std::pair<float, float>;
 struct SpanSegments {
@@ -334,6 +337,49 @@ void spawn_boost_particle(const b2WorldId& worldId,
     boost_circle_ptr->setAngle(angle + PI, worldId);
     boost_circle_ptr->apply_forward_impulse();
 }
+// Any cycle over enabled connections reads a previous run's sumOutput. Node layers go
+// stale during mutation, so they cannot rule a cycle out; Kahn's algorithm over the
+// edges does. An acyclic edge that still points to a lower layer would be evaluated
+// out of order, so that is treated as stateful too.
+bool is_feedforward(const neat::Genome& genome) {
+    const std::size_t node_count = genome.nodes.size();
+    std::vector<int> in_degree(node_count, 0);
+    std::vector<std::vector<int>> successors(node_count);
+    for (const auto& connection : genome.connections) {
+        if (!connection.enabled) {
+            continue;
+        }
+        if (connection.inNodeId < 0 || static_cast<std::size_t>(connection.inNodeId) >= node_count ||
+            connection.outNodeId < 0 || static_cast<std::size_t>(connection.outNodeId) >= node_count) {
+            return false;
+        }
+        if (genome.nodes[connection.inNodeId].layer >= genome.nodes[connection.outNodeId].layer) {
+            return false;
+        }
+        successors[connection.inNodeId].push_back(connection.outNodeId);
+        ++in_degree[connection.outNodeId];
+    }
+
+    std::vector<int> ready;
+    for (std::size_t node = 0; node < node_count; ++node) {
+        if (in_degree[node] == 0) {
+            ready.push_back(static_cast<int>(node));
+        }
+    }
+    std::size_t visited = 0;
+    while (!ready.empty()) {
+        const int node = ready.back();
+        ready.pop_back();
+        ++visited;
+        for (int next : successors[node]) {
+            if (--in_degree[next] == 0) {
+                ready.push_back(next);
+            }
+        }
+    }
+    return visited == node_count;
+}
+
 } // namespace
 
 CreatureCircle::CreatureCircle(const b2WorldId &worldId,
@@ -347,14 +393,15 @@ CreatureCircle::CreatureCircle(const b2WorldId &worldId,
                          float init_add_node_thresh,
                          float init_add_connection_thresh,
                          const neat::Genome* base_brain,
-                         std::vector<std::vector<int>>* innov_ids,
-                         int* last_innov_id,
-                         Game* owner) :
+                         InnovationRegistry* innovations,
+                         Game* owner,
+                         std::shared_ptr<neat::Genome> shared_brain) :
     EatableCircle(worldId, position_x, position_y, radius, density, /*toxic=*/false, /*division_pellet=*/false, angle, /*boost_particle=*/false),
-    brain(base_brain ? *base_brain : neat::Genome(BRAIN_INPUTS, BRAIN_OUTPUTS, innov_ids, last_innov_id, owner ? owner->get_weight_extremum_init() : 0.001f)) {
+    brain(shared_brain ? std::move(shared_brain)
+                       : base_brain ? copy_base_brain(*base_brain, owner)
+                                    : create_initial_brain(innovations, owner ? owner->get_weight_extremum_init() : 0.001f)) {
     set_kind(CircleKind::Creature);
-    neat_innovations = innov_ids;
-    neat_last_innov_id = last_innov_id;
+    neat_innovations = innovations;
     owner_game = owner;
     set_generation(generation);
     initialize_brain(
@@ -365,6 +412,69 @@ CreatureCircle::CreatureCircle(const b2WorldId &worldId,
     smooth_display_color(1.0f); // start display at brain-driven color immediately
 }
 
+CreatureCircle::~CreatureCircle() {
+    if (!owner_game) {
+        return;
+    }
+    owner_game->get_age_index().erase(*this);
+    const auto cause = poisoned ? event_trace::DeathCause::Poisoned
+                     : is_eaten() ? event_trace::DeathCause::Eaten
+                                  : event_trace::DeathCause::Removed;
+    owner_game->trace_event(event_trace::EventType::Death, *this, 0, static_cast<std::uint8_t>(cause));
+    if (brain && brain.use_count() == 1) {
+        owner_game->get_genome_pool().release(std::move(*brain));
+    }
+}
+
+void CreatureCircle::set_creation_time(float t) {
+    creation_time = t;
+    if (owner_game) {
+        owner_game->get_age_index().on_times_changed(*this);
+    }
+}
+
+void CreatureCircle::set_last_division_time(float t) {
+    last_division_time = t;
+    if (owner_game) {
+        owner_game->get_age_index().on_times_changed(*this);
+    }
+}
+
+void CreatureCircle::on_radius_changed() {
+    if (owner_game) {
+        owner_game->get_age_index().on_area_changed(*this);
+    }
+}
+
+std::shared_ptr<neat::Genome> CreatureCircle::copy_base_brain(const neat::Genome& base_brain, Game* owner) {
+    return std::make_shared<neat::Genome>(owner ? owner->get_genome_pool().acquire_copy(base_brain) : base_brain);
+}
+
+std::shared_ptr<neat::Genome> CreatureCircle::create_initial_brain(InnovationRegistry* innovations, float weight_extremum_init) {
+    if (innovations) {
+        return std::make_shared<neat::Genome>(innovations->create_genome(BRAIN_INPUTS, BRAIN_OUTPUTS, weight_extremum_init));
+    }
+    std::lock_guard<std::mutex> lock(InnovationRegistry::library_mutex());
+    return std::make_shared<neat::Genome>(BRAIN_INPUTS, BRAIN_OUTPUTS, nullptr, nullptr, weight_extremum_init);
+}
+
+bool CreatureCircle::has_feedforward_brain() const {
+    if (!topology.valid || topology.genome != brain.get() || topology.genome_version != genome_version) {
+        topology.feedforward = is_feedforward(*brain);
+        topology.genome = brain.get();
+        topology.genome_version = genome_version;
+        topology.valid = true;
+    }
+    return topology.feedforward;
+}
+
+neat::Genome& CreatureCircle::mutable_brain() {
+    if (brain.use_count() > 1) {
+        brain = copy_base_brain(*brain, owner_game);
+    }
+    return *brain;
+}
+
 float calculate_overlap_area(float r1, float r2, float distance) {
     if (distance >= r1 + r2) return 0.0f;
     if (distance <= fabs(r1 - r2)) return PI * fmin(r1, r2) * fmin(r1, r2);
@@ -385,29 +495,41 @@ float calculate_overlap_area(float r1, float r2, float distance) {
 
 void CreatureCircle::process_eating(const b2WorldId &worldId, Game& game, float poison_death_probability_toxic, float poison_death_probability_normal) {
     poisoned = false;
-    for_each_touching([&](CirclePhysics& touching_circle) {
-        if (!can_eat_circle(touching_circle)) {
-            return;
+    // Index loop: consuming never changes the candidate list (touch events only arrive after the next step).
+    for (std::size_t i = 0; i < eat_candidates.size(); ++i) {
+        EatableCircle& eatable = *eat_candidates[i];
+        if (eatable.is_eaten()) {
+            continue;
         }
-        auto* eatable = dynamic_cast<EatableCircle*>(&touching_circle);
-        if (!eatable) {
-            return;
+        if (!can_eat_circle(eatable)) {
+            continue;
         }
-        if (eatable->is_eaten()) {
-            return;
+        if (!has_overlap_to_eat(eatable)) {
+            continue;
         }
-        if (!has_overlap_to_eat(touching_circle)) {
-            return;
-        }
-        float touching_area = eatable->getArea();
-        consume_touching_circle(worldId, game, *eatable, touching_area, poison_death_probability_toxic, poison_death_probability_normal);
-    });
+        float touching_area = eatable.getArea();
+        consume_touching_circle(worldId, game, eatable, touching_area, poison_death_probability_toxic, poison_death_probability_normal);
+    }
 
     if (poisoned) {
         this->be_eaten();
     }
 }
 
+void CreatureCircle::on_touching_added(CirclePhysics* circle_physics) {
+    if (auto* eatable = circle_cast<EatableCircle>(circle_physics)) {
+        eat_candidates.push_back(eatable);
+    }
+}
+
+void CreatureCircle::on_touching_removed(CirclePhysics* circle_physics) {
+    auto it = std::find(eat_candidates.begin(), eat_candidates.end(), circle_physics);
+    if (it != eat_candidates.end()) {
+        *it = eat_candidates.back();
+        eat_candidates.pop_back();
+    }
+}
+
 bool CreatureCircle::can_eat_circle(const CirclePhysics& circle) const {
     return circle.getRadius() < this->getRadius();
 }
@@ -425,13 +547,6 @@ bool CreatureCircle::has_overlap_to_eat(const CirclePhysics& circle) const {
     const float dy = self_pos.y - other_pos.y;
     const float dist2 = dx * dx + dy * dy;
 
-    const float sum_r = r_self + r_other;
-    const float sum_r2 = sum_r * sum_r;
-    if (dist2 >= sum_r2) {
-        // No overlap possible.
-        return false;
-    }
-
     const float diff_r = r_self - r_other;
     const float diff_r2 = diff_r * diff_r;
     if (dist2 <= diff_r2) {
@@ -439,6 +554,14 @@ bool CreatureCircle::has_overlap_to_eat(const CirclePhysics& circle) const {
         return touching_area >= overlap_threshold;
     }
 
+    // Even against a flat edge, 80% of a circle is only covered once its centre is
+    // ~0.492 radii inside; our circle is convex, so anything shallower cannot qualify.
+    // This rejects the stable rim contacts without evaluating the lens area.
+    const float max_eat_distance = r_self - EAT_MIN_DEPTH_FRACTION * r_other;
+    if (max_eat_distance <= 0.0f || dist2 >= max_eat_distance * max_eat_distance) {
+        return false;
+    }
+
     const float distance = std::sqrt(dist2);
     float overlap_area = calculate_overlap_area(r_self, r_other, distance);
 
@@ -446,7 +569,8 @@ bool CreatureCircle::has_overlap_to_eat(const CirclePhysics& circle) const {
 }
 
 void CreatureCircle::consume_touching_circle(const b2WorldId &worldId, Game& game, EatableCircle& eatable, float touching_area, float poison_death_probability_toxic, float poison_death_probability_normal) {
-    float roll = static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX);
+    game.trace_event(event_trace::EventType::Eat, *this, eatable.get_entity_id(), static_cast<std::uint8_t>(eatable.get_kind()));
+    float roll = game.random_unit();
     if (eatable.is_toxic()) {
         if (roll < poison_death_probability_toxic) {
             poisoned = true;
@@ -460,7 +584,7 @@ void CreatureCircle::consume_touching_circle(const b2WorldId &worldId, Game& gam
         eatable.be_eaten();
         eatable.set_eaten_by(this);
         if (eatable.is_division_pellet()) {
-            float div_roll = static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX);
+            float div_roll = game.random_unit();
             if (div_roll <= game.get_division_pellet_divide_probability()) {
                 this->divide(worldId, game);
             }
@@ -471,26 +595,44 @@ void CreatureCircle::consume_touching_circle(const b2WorldId &worldId, Game& gam
 }
 
 void CreatureCircle::move_randomly(const b2WorldId &worldId, Game &game) {
-    float probability = static_cast<float>(rand()) / RAND_MAX;
+    float probability = game.random_unit();
     if (probability > 0.9f)
         this->boost_eccentric_forward_right(worldId, game);
 
-    probability = static_cast<float>(rand()) / RAND_MAX;
+    probability = game.random_unit();
     if (probability > 0.9f)
         this->boost_eccentric_forward_left(worldId, game);
 }
 
-void CreatureCircle::run_brain_cycle_from_touching() {
+bool CreatureCircle::run_brain_cycle_from_touching(bool reuse_unchanged) {
     update_brain_inputs_from_touching();
-    brain.loadInputs(brain_inputs.data());
-    brain.runNetwork(neat_activation);
-    brain.getOutputs(brain_outputs.data());
+    const bool same_genome = last_evaluation.valid &&
+                             last_evaluation.genome == brain.get() &&
+                             last_evaluation.genome_version == genome_version;
+    if (reuse_unchanged && same_genome && has_feedforward_brain() &&
+        std::memcmp(last_evaluation.inputs.data(), brain_inputs.data(), sizeof(brain_inputs)) == 0) {
+        update_color_from_brain();
+        return false;
+    }
+
+    // Only feedforward genomes are shared (see create_division_child), so no clone sees
+    // another's activations as recurrent input.
+    brain->loadInputs(brain_inputs.data());
+    brain->runNetwork(neat_activation);
+    brain->getOutputs(brain_outputs.data());
+    if (!same_genome) {
+        last_evaluation.genome = brain.get();
+        last_evaluation.genome_version = genome_version;
+        last_evaluation.valid = true;
+    }
+    last_evaluation.inputs = brain_inputs;
     update_color_from_brain();
+    return true;
 }
 
 void CreatureCircle::move_intelligently(const b2WorldId &worldId, Game &game, float dt) {
     (void)dt;
-    run_brain_cycle_from_touching();
+    game.count_brain_evaluation(run_brain_cycle_from_touching(game.get_skip_unchanged_brain_inputs()));
 
     if (game.get_selected_creature() == this &&
         owner_game && owner_game->is_selected_creature_possessed()
@@ -505,32 +647,22 @@ void CreatureCircle::move_intelligently(const b2WorldId &worldId, Game &game, fl
             this->divide(worldId, game);
         }
     } else {
-        float probability = static_cast<float>(rand()) / RAND_MAX;
+        float probability = game.random_unit();
         if (brain_outputs[0] >= probability) {
             this->boost_eccentric_forward_left(worldId, game);
         }
-        probability = static_cast<float>(rand()) / RAND_MAX;
+        probability = game.random_unit();
         if (brain_outputs[1] >= probability) {
             this->boost_eccentric_forward_right(worldId, game);
         }
-        probability = static_cast<float>(rand()) / RAND_MAX;
+        probability = game.random_unit();
         if (brain_outputs[2] >= probability) {
             this->divide(worldId, game);
         }
     }
 
-    if (game.get_live_mutation_enabled() && neat_innovations && neat_last_innov_id) {
-        brain.mutate(
-            neat_innovations,
-            neat_last_innov_id,
-            game.get_mutate_weight_thresh(),
-            game.get_mutate_weight_full_change_thresh(),
-            game.get_mutate_weight_factor(),
-            game.get_tick_add_connection_thresh(),
-            game.get_max_iterations_find_connection_thresh(),
-            game.get_reactivate_connection_thresh(),
-            game.get_tick_add_node_thresh(),
-            game.get_max_iterations_find_node_thresh());
+    if (game.get_live_mutation_enabled() && !game.get_scheduled_live_mutation()) {
+        apply_live_mutation(game);
     }
 
     // Update memory from dedicated memory outputs (clamped).
@@ -541,6 +673,28 @@ void CreatureCircle::move_intelligently(const b2WorldId &worldId, Game &game, fl
 
 }
 
+void CreatureCircle::apply_live_mutation(const Game& game, float rate_scale) {
+    if (!neat_innovations) {
+        return;
+    }
+    auto scaled = [rate_scale](float thresh) { return std::min(1.0f, thresh * rate_scale); };
+    neat::Genome& genome = mutable_brain();
+    neat_innovations->mutate(genome, [&](auto* innovations, auto* last_innovation_id) {
+        genome.mutate(
+            innovations,
+            last_innovation_id,
+            scaled(game.get_mutate_weight_thresh()),
+            game.get_mutate_weight_full_change_thresh(),
+            game.get_mutate_weight_factor(),
+            scaled(game.get_tick_add_connection_thresh()),
+            game.get_max_iterations_find_connection_thresh(),
+            game.get_reactivate_connection_thresh(),
+            scaled(game.get_tick_add_node_thresh()),
+            game.get_max_iterations_find_node_thresh());
+    });
+    ++genome_version;
+}
+
 void CreatureCircle::update_inactivity(float dt, float timeout) {
     if (dt <= 0.0f) return;
     inactivity_timer += dt;
@@ -665,7 +819,7 @@ void CreatureCircle::initialize_brain(int mutation_rounds, float add_node_thresh
     // Mutate repeatedly to seed a non-trivial brain topology.
     int rounds = std::max(0, mutation_rounds);
     for (int i = 0; i < rounds; ++i) {
-        if (neat_innovations && neat_last_innov_id) {
+        if (neat_innovations) {
             float weight_thresh = 0.8f;
             float weight_full = 0.1f;
             float weight_factor = 1.2f;
@@ -680,22 +834,29 @@ void CreatureCircle::initialize_brain(int mutation_rounds, float add_node_thresh
                 add_conn_iters = owner_game->get_max_iterations_find_connection_thresh();
                 add_node_iters = owner_game->get_max_iterations_find_node_thresh();
             }
-            brain.mutate(
-                neat_innovations,
-                neat_last_innov_id,
-                weight_thresh,
-                weight_full,
-                weight_factor,
-                add_connection_thresh,
-                add_conn_iters,
-                reactivate,
-                add_node_thresh,
-                add_node_iters);
+            neat::Genome& genome = mutable_brain();
+            neat_innovations->mutate(genome, [&](auto* innovations, auto* last_innovation_id) {
+                genome.mutate(
+                    innovations,
+                    last_innovation_id,
+                    weight_thresh,
+                    weight_full,
+                    weight_factor,
+                    add_connection_thresh,
+                    add_conn_iters,
+                    reactivate,
+                    add_node_thresh,
+                    add_node_iters);
+            });
+            ++genome_version;
         }
     }
 }
 
 void CreatureCircle::divide(const b2WorldId &worldId, Game& game) {
+    if (!game.get_qos_governor().allows_new_creature(game.get_age_index().size())) {
+        return;
+    }
     const float current_area = this->getArea();
     const float divided_area = current_area / 2.0f;
 
@@ -704,7 +865,6 @@ void CreatureCircle::divide(const b2WorldId &worldId, Game& game) {
     }
 
     const float new_radius = std::sqrt(divided_area / PI);
-    neat::Genome parent_brain_copy = brain;
 
     const b2Vec2 original_pos = this->getPosition();
     const float angle = this->getAngle();
@@ -720,12 +880,14 @@ void CreatureCircle::divide(const b2WorldId &worldId, Game& game) {
         new_radius,
         angle,
         next_generation,
-        child_position,
-        parent_brain_copy);
+        child_position);
     CreatureCircle* new_circle_ptr = new_circle.get();
 
     apply_post_division_updates(game, new_circle_ptr, next_generation);
     game.add_circle(std::move(new_circle));
+    if (new_circle_ptr) {
+        game.trace_event(event_trace::EventType::Division, *this, new_circle_ptr->get_entity_id());
+    }
 }
 
 bool CreatureCircle::has_sufficient_area_for_division(float divided_area) const {
@@ -746,8 +908,11 @@ std::unique_ptr<CreatureCircle> CreatureCircle::create_division_child(const b2Wo
                                                                       float new_radius,
                                                                       float angle,
                                                                       int next_generation,
-                                                                      const b2Vec2& child_position,
-                                                                      const neat::Genome& parent_brain_copy) {
+                                                                      const b2Vec2& child_position) {
+    // A feedforward genome holds no state between runs, so the child can share it until
+    // mutate_lineage splits them. Recurrent links read the previous run's node outputs,
+    // so those genomes are copied to give each clone its own memory.
+    const bool share_brain = has_feedforward_brain();
     auto new_circle = std::make_unique<CreatureCircle>(
         worldId,
         child_position.x,
@@ -756,16 +921,17 @@ std::unique_ptr<CreatureCircle> CreatureCircle::create_division_child(const b2Wo
         game.get_circle_density(),
         angle + PI,
         next_generation,
-        game.get_init_mutation_rounds(),
+        0,
         game.get_init_add_node_thresh(),
         game.get_init_add_connection_thresh(),
-        &brain,
-        game.get_neat_innovations(),
-        game.get_neat_last_innovation_id(),
-        &game);
+        share_brain ? nullptr : brain.get(),
+        &game.get_innovation_registry(),
+        &game,
+        share_brain ? brain : nullptr);
 
     if (new_circle) {
-        configure_child_after_division(*new_circle, worldId, game, angle, parent_brain_copy);
+        new_circle->parent_entity_id = get_entity_id();
+        configure_child_after_division(*new_circle, worldId, game, angle);
     }
 
     return new_circle;
@@ -779,9 +945,6 @@ void CreatureCircle::apply_post_division_updates(Game& game, CreatureCircle* chi
 
     owner_game = &game;
     set_last_division_time(game.get_sim_time());
-    if (owner_game) {
-        owner_game->mark_age_dirty();
-    }
 
     game.update_max_generation_from_circle(this);
     game.update_max_generation_from_circle(child);
@@ -793,8 +956,7 @@ void CreatureCircle::apply_post_division_updates(Game& game, CreatureCircle* chi
     update_color_from_brain();
 }
 
-void CreatureCircle::configure_child_after_division(CreatureCircle& child, const b2WorldId& worldId, const Game& game, float angle, const neat::Genome& parent_brain_copy) const {
-    child.brain = parent_brain_copy;
+void CreatureCircle::configure_child_after_division(CreatureCircle& child, const b2WorldId& worldId, const Game& game, float angle) const {
     child.set_impulse_magnitudes(game.get_linear_impulse_magnitude(), game.get_angular_impulse_magnitude());
     child.set_linear_damping(game.get_linear_damping(), worldId);
     child.set_angular_damping(game.get_angular_damping(), worldId);
@@ -815,31 +977,43 @@ void CreatureCircle::mutate_lineage(const Game& game, CreatureCircle* child) {
     int add_conn_iters = game.get_max_iterations_find_connection_thresh();
     int add_node_iters = game.get_max_iterations_find_node_thresh();
     for (int i = 0; i < mutation_rounds; ++i) {
-        if (neat_innovations && neat_last_innov_id) {
-            brain.mutate(
-                neat_innovations,
-                neat_last_innov_id,
-                weight_thresh,
-                weight_full,
-                weight_factor,
-                game.get_add_connection_thresh(),
-                add_conn_iters,
-                reactivate,
-                game.get_add_node_thresh(),
-                add_node_iters);
-        }
-        if (child && child->neat_innovations && child->neat_last_innov_id) {
-            child->brain.mutate(
-                child->neat_innovations,
-                child->neat_last_innov_id,
-                weight_thresh,
-                weight_full,
-                weight_factor,
-                game.get_add_connection_thresh(),
-                add_conn_iters,
-                reactivate,
-                game.get_add_node_thresh(),
-                add_node_iters);
+        if (neat_innovations) {
+            neat::Genome& genome = mutable_brain();
+            neat_innovations->mutate(genome, [&](auto* innovations, auto* last_innovation_id) {
+                genome.mutate(
+                    innovations,
+                    last_innovation_id,
+                    weight_thresh,
+                    weight_full,
+                    weight_factor,
+                    game.get_add_connection_thresh(),
+                    add_conn_iters,
+                    reactivate,
+                    game.get_add_node_thresh(),
+                    add_node_iters);
+            });
+        }
+        if (child && child->neat_innovations) {
+            neat::Genome& child_genome = child->mutable_brain();
+            child->neat_innovations->mutate(child_genome, [&](auto* innovations, auto* last_innovation_id) {
+                child_genome.mutate(
+                    innovations,
+                    last_innovation_id,
+                    weight_thresh,
+                    weight_full,
+                    weight_factor,
+                    game.get_add_connection_thresh(),
+                    add_conn_iters,
+                    reactivate,
+                    game.get_add_node_thresh(),
+                    add_node_iters);
+            });
+        }
+    }
+    if (mutation_rounds > 0) {
+        ++genome_version;
+        if (child) {
+            ++child->genome_version;
         }
     }
 }
@@ -865,7 +1039,7 @@ void CreatureCircle::update_brain_inputs_from_touching() {
 
     if (!touching_circles.empty()) {
         for_each_touching([&](const CirclePhysics& circle) {
-            auto* drawable = dynamic_cast<const DrawableCircle*>(&circle);
+            auto* drawable = circle_cast<DrawableCircle>(&circle);
             if (!drawable) {
                 return;
             }
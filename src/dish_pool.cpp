@@ -0,0 +1,108 @@
+#include "dish_pool.hpp"
+
+#include <algorithm>
+#include <random>
+
+DishPool::DishPool(std::size_t dish_count, std::size_t thread_count, std::uint32_t base_seed) {
+    dish_count = std::clamp<std::size_t>(dish_count, 1, MAX_DISHES);
+
+    // Worlds are created here on the calling thread; b2CreateWorld is not thread-safe.
+    std::seed_seq seq{base_seed};
+    std::vector<std::uint32_t> seeds(dish_count);
+    seq.generate(seeds.begin(), seeds.end());
+    dishes.reserve(dish_count);
+    for (std::uint32_t seed : seeds) {
+        dishes.push_back(std::make_unique<Game>(seed));
+    }
+
+    if (thread_count == 0) {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    // The calling thread works too, so it counts as one of the threads.
+    const std::size_t worker_count = std::min(thread_count, dish_count) - 1;
+    workers.reserve(worker_count);
+    for (std::size_t i = 0; i < worker_count; ++i) {
+        workers.emplace_back(&DishPool::worker_loop, this);
+    }
+}
+
+DishPool::~DishPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    work_ready.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    dishes.clear();
+}
+
+void DishPool::for_each_parallel(const std::function<void(Game&)>& fn) {
+    for_each_parallel_indexed([&fn](std::size_t, Game& dish) { fn(dish); });
+}
+
+void DishPool::for_each_parallel_indexed(const std::function<void(std::size_t, Game&)>& fn) {
+    if (workers.empty()) {
+        for (std::size_t i = 0; i < dishes.size(); ++i) {
+            fn(i, *dishes[i]);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &fn;
+        next_dish = 0;
+        finished_dishes = 0;
+        ++job_generation;
+    }
+    work_ready.notify_all();
+
+    run_claimed_jobs();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    work_done.wait(lock, [&] { return finished_dishes == dishes.size(); });
+    job = nullptr;
+}
+
+void DishPool::run_claimed_jobs() {
+    for (;;) {
+        std::size_t index;
+        const std::function<void(std::size_t, Game&)>* current_job;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!job || next_dish >= dishes.size()) {
+                return;
+            }
+            index = next_dish++;
+            current_job = job;
+        }
+
+        (*current_job)(index, *dishes[index]);
+
+        bool all_done;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            all_done = ++finished_dishes == dishes.size();
+        }
+        if (all_done) {
+            work_done.notify_one();
+        }
+    }
+}
+
+void DishPool::worker_loop() {
+    std::uint64_t seen_generation = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            work_ready.wait(lock, [&] { return stopping || job_generation != seen_generation; });
+            if (stopping) {
+                return;
+            }
+            seen_generation = job_generation;
+        }
+        run_claimed_jobs();
+    }
+}
@@ -1,35 +1,35 @@
 #include "drawable_circle.hpp"
 
-#include <cstdlib>
 #include <algorithm>
 
-DrawableCircle::DrawableCircle(const b2WorldId &worldId, float position_x, float position_y, float radius, float density, float angle, CircleKind kind) :
+DrawableCircle::DrawableCircle(const b2WorldId &worldId, float position_x, float position_y, float radius, float density, float angle, CircleKind kind, bool with_body) :
     CirclePhysics(worldId, CirclePhysics::Config{
         b2Vec2{position_x, position_y},
         radius,
         density,
         angle,
-        kind
+        kind,
+        with_body
     }) {
-    for (auto& c : color_rgb) {
-        c = std::clamp(static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX), 0.0f, 1.0f);
-    }
-    display_color_rgb = color_rgb;
+    // Every subclass sets its own colour, so the base starts black.
     display_color_initialized = true;
 }
 
-void DrawableCircle::draw(sf::RenderWindow& window) const {
-    sf::CircleShape shape(getRadius());
-    sf::Color fill{
+sf::Color DrawableCircle::get_fill_color() const {
+    return sf::Color{
         static_cast<std::uint8_t>((use_smoothed_display ? display_color_rgb[0] : color_rgb[0]) * 255.0f),
         static_cast<std::uint8_t>((use_smoothed_display ? display_color_rgb[1] : color_rgb[1]) * 255.0f),
         static_cast<std::uint8_t>((use_smoothed_display ? display_color_rgb[2] : color_rgb[2]) * 255.0f)
     };
-    shape.setFillColor(fill);
+}
+
+void DrawableCircle::draw(sf::RenderTarget& target) const {
+    sf::CircleShape shape(getRadius());
+    shape.setFillColor(get_fill_color());
 
     shape.setOrigin({getRadius(), getRadius()});
     shape.setPosition({getPosition().x, getPosition().y});
-    window.draw(shape);
+    target.draw(shape);
 
     if (should_draw_direction_indicator()) {
         sf::RectangleShape line({getRadius(), getRadius() / 4.0f});
@@ -39,7 +39,7 @@ void DrawableCircle::draw(sf::RenderWindow& window) const {
         line.setOrigin({0, getRadius() / 4.0f / 2.0f});
         line.setPosition({getPosition().x, getPosition().y});
 
-        window.draw(line);
+        target.draw(line);
     }
 }
 
@@ -1,7 +1,7 @@
 #include "eatable_circle.hpp"
 #include "creature_circle.hpp"
 
-EatableCircle::EatableCircle(const b2WorldId &worldId, float position_x, float position_y, float radius, float density, bool toxic, bool division_pellet, float angle, bool boost_particle) :
+EatableCircle::EatableCircle(const b2WorldId &worldId, float position_x, float position_y, float radius, float density, bool toxic, bool division_pellet, float angle, bool boost_particle, bool with_body) :
     DrawableCircle(
         worldId,
         position_x,
@@ -12,7 +12,8 @@ EatableCircle::EatableCircle(const b2WorldId &worldId, float position_x, float p
         boost_particle ? CircleKind::BoostParticle
                        : division_pellet ? CircleKind::DivisionPellet
                                          : toxic ? CircleKind::ToxicPellet
-                                                 : CircleKind::Pellet),
+                                                 : CircleKind::Pellet,
+        with_body),
     toxic(toxic),
     division_pellet(division_pellet),
     boost_particle(boost_particle) {
@@ -0,0 +1,100 @@
+#include "event_trace.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace event_trace {
+namespace {
+constexpr char FILE_MAGIC[4] = {'P', 'D', 'E', 'V'};
+constexpr auto WRITER_PERIOD = std::chrono::milliseconds(5);
+} // namespace
+
+Recorder::Recorder(std::size_t capacity_log2)
+    : ring(std::size_t{1} << capacity_log2),
+      mask((std::uint64_t{1} << capacity_log2) - 1) {}
+
+Recorder::~Recorder() {
+    close();
+}
+
+bool Recorder::open(const std::string& path) {
+    close();
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+    const std::uint32_t record_size = sizeof(Event);
+    out.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+    out.write(reinterpret_cast<const char*>(&FORMAT_VERSION), sizeof(FORMAT_VERSION));
+    out.write(reinterpret_cast<const char*>(&record_size), sizeof(record_size));
+    stopping.store(false, std::memory_order_relaxed);
+    writer = std::thread([this]() { writer_loop(); });
+    return static_cast<bool>(out);
+}
+
+void Recorder::close() {
+    if (writer.joinable()) {
+        stopping.store(true, std::memory_order_release);
+        writer.join();
+    }
+    if (out.is_open()) {
+        drain();
+        out.close();
+    }
+}
+
+void Recorder::drain() {
+    const std::uint64_t tail = read_index.load(std::memory_order_relaxed);
+    const std::uint64_t head = write_index.load(std::memory_order_acquire);
+    if (head == tail) {
+        return;
+    }
+    // At most two contiguous runs: up to the end of the ring, then from its start.
+    const std::uint64_t first = tail & mask;
+    const std::uint64_t count = head - tail;
+    const std::uint64_t until_wrap = std::min<std::uint64_t>(count, ring.size() - first);
+    out.write(reinterpret_cast<const char*>(&ring[first]), static_cast<std::streamsize>(until_wrap * sizeof(Event)));
+    if (count > until_wrap) {
+        out.write(reinterpret_cast<const char*>(ring.data()), static_cast<std::streamsize>((count - until_wrap) * sizeof(Event)));
+    }
+    read_index.store(head, std::memory_order_release);
+}
+
+void Recorder::writer_loop() {
+    while (!stopping.load(std::memory_order_acquire)) {
+        drain();
+        out.flush();
+        std::this_thread::sleep_for(WRITER_PERIOD);
+    }
+    drain();
+    out.flush();
+}
+
+bool Reader::open(const std::string& path, std::string& error) {
+    in.open(path, std::ios::binary);
+    if (!in) {
+        error = "cannot open " + path;
+        return false;
+    }
+    char magic[4];
+    std::uint32_t version = 0;
+    std::uint32_t record_size = 0;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, FILE_MAGIC, sizeof(magic)) != 0) {
+        error = path + " is not an event trace";
+        return false;
+    }
+    in.read(reinterpret_cast<char*>(&version), sizeof(version));
+    in.read(reinterpret_cast<char*>(&record_size), sizeof(record_size));
+    if (!in || version != FORMAT_VERSION || record_size != sizeof(Event)) {
+        error = "unsupported event trace version " + std::to_string(version);
+        return false;
+    }
+    return true;
+}
+
+bool Reader::next(Event& event) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&event), sizeof(Event)));
+}
+
+} // namespace event_trace
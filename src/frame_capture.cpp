@@ -0,0 +1,206 @@
+#include "frame_capture.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+#include <SFML/OpenGL.hpp>
+
+namespace {
+constexpr std::size_t BUFFERS_PER_ENCODER = 2;
+constexpr float DISH_MARGIN = 1.05f;
+
+// glReadPixels returns the bottom row first.
+void flip_rows(std::vector<std::uint8_t>& pixels, std::size_t row_bytes) {
+    const std::size_t rows = pixels.size() / row_bytes;
+    for (std::size_t top = 0, bottom = rows - 1; top < bottom; ++top, --bottom) {
+        std::swap_ranges(pixels.begin() + static_cast<std::ptrdiff_t>(top * row_bytes),
+                         pixels.begin() + static_cast<std::ptrdiff_t>((top + 1) * row_bytes),
+                         pixels.begin() + static_cast<std::ptrdiff_t>(bottom * row_bytes));
+    }
+}
+} // namespace
+
+FrameCapture::FrameCapture(DishPool& pool_ref)
+    : pool(pool_ref) {}
+
+FrameCapture::~FrameCapture() {
+    stop();
+}
+
+bool FrameCapture::start(const Settings& new_settings, std::string& error) {
+    stop();
+    if (new_settings.prefix.empty()) {
+        error = "capture prefix is empty";
+        return false;
+    }
+    if (new_settings.size.x == 0 || new_settings.size.y == 0) {
+        error = "capture size must be positive";
+        return false;
+    }
+    settings = new_settings;
+    settings.interval = std::max(settings.interval, 0.0f);
+
+    target = std::make_unique<sf::RenderTexture>();
+    if (!target->resize(settings.size)) {
+        target.reset();
+        error = "cannot create a " + std::to_string(settings.size.x) + "x" + std::to_string(settings.size.y) + " render texture";
+        return false;
+    }
+
+    next_time.assign(pool.size(), 0.0f);
+    for (std::size_t i = 0; i < pool.size(); ++i) {
+        next_time[i] = pool.dish(i).get_sim_time();
+    }
+    frame_counts.assign(pool.size(), 0);
+
+    std::size_t threads = settings.encoder_threads;
+    if (threads == 0) {
+        threads = std::max<std::size_t>(1, std::thread::hardware_concurrency() / 2);
+    }
+    max_buffers = threads * BUFFERS_PER_ENCODER;
+    allocated_buffers = 0;
+    free_buffers.clear();
+    stopping = false;
+    for (std::size_t i = 0; i < threads; ++i) {
+        encoders.emplace_back([this] { encoder_loop(); });
+    }
+    active = true;
+    return true;
+}
+
+void FrameCapture::stop() {
+    if (!active) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    work_ready.notify_all();
+    for (auto& encoder : encoders) {
+        encoder.join();
+    }
+    encoders.clear();
+    free_buffers.clear();
+    target.reset();
+    active = false;
+}
+
+void FrameCapture::update() {
+    if (!active) {
+        return;
+    }
+    for (std::size_t i = 0; i < pool.size(); ++i) {
+        const float now = pool.dish(i).get_sim_time();
+        if (now < next_time[i]) {
+            continue;
+        }
+        capture_dish(i);
+        next_time[i] += settings.interval;
+        // After a long stall, resume the cadence from now rather than bursting frames.
+        if (next_time[i] <= now) {
+            next_time[i] = now + settings.interval;
+        }
+    }
+}
+
+void FrameCapture::capture_dish(std::size_t index) {
+    std::vector<std::uint8_t> pixels;
+    if (!acquire_buffer(pixels)) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    const Game& game = pool.dish(index);
+    const float aspect = static_cast<float>(settings.size.x) / static_cast<float>(settings.size.y);
+    const float height = game.get_petri_radius() * 2.0f * DISH_MARGIN;
+    target->setView(sf::View({0.0f, 0.0f}, {height * aspect, height}));
+    target->clear();
+    game.draw(*target);
+    target->display();
+
+    // The readback is the only synchronous cost; encoding happens on the workers.
+    // Reading into the pooled buffer avoids the sf::Image that copyToImage() allocates
+    // per frame. Rows arrive bottom-up and are flipped by the encoder.
+    if (!target->setActive(true)) {
+        release_buffer(std::move(pixels));
+        failed.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    pixels.resize(static_cast<std::size_t>(settings.size.x) * settings.size.y * 4);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, static_cast<GLsizei>(settings.size.x), static_cast<GLsizei>(settings.size.y), GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    (void)target->setActive(false);
+
+    // Numbered only once queued, so dropped frames leave no gaps for ffmpeg's %06d.
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(Job{index, frame_counts[index]++, std::move(pixels)});
+    }
+    work_ready.notify_one();
+}
+
+bool FrameCapture::acquire_buffer(std::vector<std::uint8_t>& buffer) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!free_buffers.empty()) {
+        buffer = std::move(free_buffers.back());
+        free_buffers.pop_back();
+        return true;
+    }
+    if (allocated_buffers < max_buffers) {
+        ++allocated_buffers;
+        buffer.clear();
+        return true;
+    }
+    return false;
+}
+
+void FrameCapture::release_buffer(std::vector<std::uint8_t>&& buffer) {
+    std::lock_guard<std::mutex> lock(mutex);
+    free_buffers.push_back(std::move(buffer));
+}
+
+void FrameCapture::encoder_loop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        work_ready.wait(lock, [this] { return stopping || !queue.empty(); });
+        if (queue.empty()) {
+            return;
+        }
+        Job job = std::move(queue.front());
+        queue.pop_front();
+        lock.unlock();
+        flip_rows(job.pixels, static_cast<std::size_t>(settings.size.x) * 4);
+        encode(job);
+        lock.lock();
+        free_buffers.push_back(std::move(job.pixels));
+    }
+}
+
+void FrameCapture::encode(const Job& job) {
+    const std::string path = frame_path(job.dish, job.frame);
+    bool ok = false;
+    if (settings.format == Format::Png) {
+        const sf::Image image(settings.size, job.pixels.data());
+        ok = image.saveToFile(path);
+    } else {
+        std::ofstream out(path, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(job.pixels.data()), static_cast<std::streamsize>(job.pixels.size()));
+        ok = static_cast<bool>(out);
+    }
+    (ok ? written : failed).fetch_add(1, std::memory_order_relaxed);
+}
+
+// "frames/run" becomes "frames/run_000042.png", or "frames/run.dish3_000042.png" with several dishes.
+std::string FrameCapture::frame_path(std::size_t dish, std::size_t frame) const {
+    char number[32];
+    std::snprintf(number, sizeof(number), "_%06zu", frame);
+    std::string path = settings.prefix;
+    if (pool.size() > 1) {
+        path += ".dish" + std::to_string(dish);
+    }
+    path += number;
+    path += settings.format == Format::Png ? ".png" : ".rgba";
+    return path;
+}
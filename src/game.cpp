@@ -2,10 +2,10 @@
 #include <algorithm>
 #include <limits>
 #include <numeric>
-#include <random>
 
 #include "game.hpp"
 #include "creature_circle.hpp"
+#include "physics_allocator.hpp"
 
 namespace {
 CirclePhysics* circle_from_shape(const b2ShapeId& shapeId) {
@@ -41,7 +41,6 @@ void handle_sensor_end_touch(const b2SensorEndTouchEvent& endTouch) {
 }
 
 Game::SelectionMode sanitize_selection_mode(Game::SelectionMode mode) {
-#ifndef NDEBUG
     switch (mode) {
         case Game::SelectionMode::Manual:
         case Game::SelectionMode::OldestLargest:
@@ -49,28 +48,26 @@ Game::SelectionMode sanitize_selection_mode(Game::SelectionMode mode) {
         case Game::SelectionMode::OldestSmallest:
             return mode;
     }
-#else
-    switch (mode) {
-        case Game::SelectionMode::Manual:
-        case Game::SelectionMode::OldestLargest:
-        case Game::SelectionMode::OldestSmallest:
-            return mode;
-    }
-#endif
     return Game::SelectionMode::Manual;
 }
 } // namespace
 
-Game::Game()
-    : selection(circles, timing.sim_time_accum),
-      spawner(*this) {
+Game::Game(std::uint32_t seed)
+    : seed(seed),
+      rng(seed),
+      selection(circles, timing.sim_time_accum, age_index),
+      spawner(*this),
+      qos(*this) {
     b2WorldDef worldDef = b2DefaultWorldDef();
     worldDef.gravity = b2Vec2{0.0f, 0.0f};
+    worldDef.userData = &collision_filter;
     worldId = b2CreateWorld(&worldDef);
-    age.dirty = true;
 }
 
 Game::~Game() {
+    stop_telemetry();
+    stop_event_trace();
+    genome_pool.set_accepting(false);
     circles.clear();
     b2DestroyWorld(worldId);
 }
@@ -90,6 +87,18 @@ void process_touch_events(const b2WorldId& worldId) {
     }
 }
 
+// Box2D reports every body the solver moved; copying their transforms once here
+// lets the rest of the tick read positions without going back into the world.
+void process_body_move_events(const b2WorldId& worldId) {
+    b2BodyEvents bodyEvents = b2World_GetBodyEvents(worldId);
+    for (int i = 0; i < bodyEvents.moveCount; ++i) {
+        const b2BodyMoveEvent& move = bodyEvents.moveEvents[i];
+        if (auto* circle = static_cast<CirclePhysics*>(move.userData)) {
+            circle->sync_from_move_event(move);
+        }
+    }
+}
+
 void Game::process_game_logic_with_speed() {
     if (paused) {
         timing.last_sim_dt = 0.0f;
@@ -121,12 +130,18 @@ void Game::process_game_logic_with_speed() {
 }
 
 void Game::process_game_logic() {
+    const bool governed = qos.get_settings().enabled;
+    const auto tick_start = governed ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
     float timeStep = (1.0f / 60.0f);
     int subStepCount = 4;
     b2World_Step(worldId, timeStep, subStepCount);
     timing.sim_time_accum += timeStep;
+    ++timing.tick;
 
+    process_body_move_events(worldId);
     process_touch_events(worldId);
+    settle_pushed_pellets();
+    update_lightweight_pellet_touches();
 
     brain.time_accumulator += timeStep;
     spawner.sprinkle_entities(timeStep);
@@ -134,9 +149,14 @@ void Game::process_game_logic() {
     run_brain_updates(worldId, timeStep);
     cleanup_pellets_by_rate(timeStep);
     finalize_world_state();
+    compact_innovations_if_due();
+    record_telemetry_if_due();
+    if (governed) {
+        qos.record_tick(std::chrono::duration<float>(std::chrono::steady_clock::now() - tick_start).count(), timeStep);
+    }
 }
 
-void Game::draw(sf::RenderWindow& window) const {
+void Game::draw(sf::RenderTarget& target) const {
     // Draw petri dish boundary
     sf::CircleShape boundary(dish.radius);
     boundary.setOrigin({dish.radius, dish.radius});
@@ -144,10 +164,44 @@ void Game::draw(sf::RenderWindow& window) const {
     boundary.setOutlineColor(sf::Color::Red);
     boundary.setOutlineThickness(0.2f);
     boundary.setFillColor(sf::Color::Transparent);
-    window.draw(boundary);
-
-    for (const auto& circle : circles) {
-        circle->draw(window);
+    target.draw(boundary);
+
+    render.total = circles.size();
+    const sf::View& view = target.getView();
+    const sf::FloatRect view_rect{view.getCenter() - view.getSize() / 2.0f, view.getSize()};
+    const float dish_extent = dish.radius + 1.0f;
+    const bool whole_dish_visible =
+        view_rect.position.x <= -dish_extent && view_rect.position.y <= -dish_extent &&
+        view_rect.position.x + view_rect.size.x >= dish_extent &&
+        view_rect.position.y + view_rect.size.y >= dish_extent;
+    const bool cull = render.view_culling && !whole_dish_visible && view.getRotation().asDegrees() == 0.0f;
+    if (cull) {
+        render.culler.rebuild(circles);
+        render.culler.query(view_rect, render.visible);
+    }
+    render.drawn = cull ? render.visible.size() : circles.size();
+
+    if (render.level_of_detail) {
+        render.lod.begin(target);
+    }
+    auto draw_circle = [&](const EatableCircle& circle) {
+        if (render.level_of_detail) {
+            render.lod.submit(circle);
+        } else {
+            circle.draw(target);
+        }
+    };
+    if (cull) {
+        for (std::uint32_t index : render.visible) {
+            draw_circle(*circles[index]);
+        }
+    } else {
+        for (const auto& circle : circles) {
+            draw_circle(*circle);
+        }
+    }
+    if (render.level_of_detail) {
+        render.lod.finish(target);
     }
 }
 
@@ -317,29 +371,73 @@ void Game::handle_key_release(const sf::Event::KeyReleased& e) {
 }
 
 void Game::add_circle(std::unique_ptr<EatableCircle> circle) {
+    if (circle->get_entity_id() == 0) {
+        circle->set_entity_id(next_entity_id++);
+    }
     update_max_generation_from_circle(circle.get());
     adjust_pellet_count(circle.get(), 1);
-    if (!age.dirty && circle && circle->get_kind() == CircleKind::Creature) {
-        auto* creature_circle = static_cast<CreatureCircle*>(circle.get());
-        const float creation_time = creature_circle->get_creation_time();
-        const float division_time = creature_circle->get_last_division_time();
-        if (!age.has_creature) {
-            age.has_creature = true;
-            age.min_creation_time = creation_time;
-            age.min_division_time = division_time;
-        } else {
-            age.min_creation_time = std::min(age.min_creation_time, creation_time);
-            age.min_division_time = std::min(age.min_division_time, division_time);
-        }
-        age.max_age_since_creation = std::max(0.0f, timing.sim_time_accum - age.min_creation_time);
-        age.max_age_since_division = std::max(0.0f, timing.sim_time_accum - age.min_division_time);
-    }
-    if (circle && circle->get_kind() == CircleKind::Creature) {
+    if (auto* creature_circle = circle_cast<CreatureCircle>(circle.get())) {
+        const float brain_hz = qos.governed_brain_hz(brain.updates_per_second);
+        const float brain_period = brain_hz > 0.0f ? 1.0f / brain_hz : 0.0f;
+        creature_circle->brain_update_accumulator() = next_brain_phase() * brain_period;
+        age_index.insert(*creature_circle);
+        // Only division children have a parent; spawner top-ups and migrants just arrive.
+        ++(creature_circle->get_parent_entity_id() != 0 ? telemetry.births : telemetry.arrivals);
+        trace_event(event_trace::EventType::Birth, *creature_circle, creature_circle->get_parent_entity_id());
         mark_selection_dirty();
     }
     circles.push_back(std::move(circle));
 }
 
+std::vector<Game::Migrant> Game::export_migrants(std::size_t count, MigrantRank rank) const {
+    std::vector<const CreatureCircle*> creatures;
+    for (const auto& circle : circles) {
+        if (const auto* creature_circle = circle_cast<CreatureCircle>(circle.get())) {
+            creatures.push_back(creature_circle);
+        }
+    }
+    count = std::min(count, creatures.size());
+
+    auto ranks_before = [rank](const CreatureCircle* a, const CreatureCircle* b) {
+        if (rank == MigrantRank::Oldest && a->get_creation_time() != b->get_creation_time()) {
+            return a->get_creation_time() < b->get_creation_time();
+        }
+        return a->getArea() > b->getArea();
+    };
+    std::partial_sort(creatures.begin(), creatures.begin() + static_cast<std::ptrdiff_t>(count), creatures.end(), ranks_before);
+
+    std::vector<Migrant> migrants;
+    migrants.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        migrants.push_back(Migrant{creatures[i]->get_brain(), creatures[i]->getArea(), creatures[i]->get_generation()});
+    }
+    return migrants;
+}
+
+void Game::import_migrants(std::vector<Migrant> migrants) {
+    for (auto& migrant : migrants) {
+        // Innovation ids are per dish; map the connections onto ours before the genome mutates here.
+        innovations.reconcile(migrant.brain);
+        if (auto creature_circle = spawner.create_creature_at(spawner.random_point_in_petri(), &migrant.brain)) {
+            creature_circle->setArea(migrant.area, worldId);
+            creature_circle->set_generation(migrant.generation);
+            add_circle(std::move(creature_circle));
+        }
+    }
+}
+
+void Game::set_collision_pair(CircleKind a, CircleKind b, bool enabled) {
+    if (collision_filter.get_pair(a, b) == enabled) {
+        return;
+    }
+    collision_filter.set_pair(a, b, enabled);
+    for (auto& circle : circles) {
+        if (circle->get_kind() == a || circle->get_kind() == b) {
+            circle->refresh_collision_filter();
+        }
+    }
+}
+
 std::size_t Game::get_creature_count() const {
     std::size_t count = 0;
     for (const auto& c : circles) {
@@ -374,11 +472,9 @@ const CreatureCircle* Game::get_oldest_smallest_creature() const {
     return selection.get_oldest_smallest_creature();
 }
 
-#ifndef NDEBUG
 const CreatureCircle* Game::get_oldest_middle_creature() const {
     return selection.get_oldest_middle_creature();
 }
-#endif
 
 const CreatureCircle* Game::get_follow_target_creature() const {
     return selection.get_follow_target_creature();
@@ -423,11 +519,9 @@ void Game::apply_selection_mode() {
         case SelectionMode::OldestLargest:
             selection.set_selection_to_creature(selection.get_oldest_largest_creature());
             break;
-#ifndef NDEBUG
         case SelectionMode::OldestMedian:
             selection.set_selection_to_creature(selection.get_oldest_middle_creature());
             break;
-#endif
         case SelectionMode::OldestSmallest:
             selection.set_selection_to_creature(selection.get_oldest_smallest_creature());
             break;
@@ -440,8 +534,7 @@ void Game::apply_selection_mode() {
 }
 
 void Game::update_max_generation_from_circle(const EatableCircle* circle) {
-    if (circle && circle->get_kind() == CircleKind::Creature) {
-        const auto* creature_circle = static_cast<const CreatureCircle*>(circle);
+    if (const auto* creature_circle = circle_cast<CreatureCircle>(circle)) {
         if (creature_circle->get_generation() > generation.max_generation) {
             generation.max_generation = creature_circle->get_generation();
             generation.brain = creature_circle->get_brain();
@@ -451,57 +544,28 @@ void Game::update_max_generation_from_circle(const EatableCircle* circle) {
 
 void Game::recompute_max_generation() {
     int new_max = 0;
-    std::optional<neat::Genome> new_brain;
+    const CreatureCircle* new_holder = nullptr;
     for (const auto& circle : circles) {
-        if (circle && circle->get_kind() == CircleKind::Creature) {
-            const auto* creature_circle = static_cast<const CreatureCircle*>(circle.get());
+        if (const auto* creature_circle = circle_cast<CreatureCircle>(circle.get())) {
             if (creature_circle->get_generation() >= new_max) {
                 new_max = creature_circle->get_generation();
-                new_brain = creature_circle->get_brain();
+                new_holder = creature_circle;
             }
         }
     }
     generation.max_generation = new_max;
-    generation.brain = std::move(new_brain);
-}
-
-void Game::update_max_ages() {
-    if (age.dirty) {
-        float creation_min = std::numeric_limits<float>::max();
-        float division_min = std::numeric_limits<float>::max();
-        bool found = false;
-        for (const auto& circle : circles) {
-            if (circle && circle->get_kind() == CircleKind::Creature) {
-                const auto* creature_circle = static_cast<const CreatureCircle*>(circle.get());
-                creation_min = std::min(creation_min, creature_circle->get_creation_time());
-                division_min = std::min(division_min, creature_circle->get_last_division_time());
-                found = true;
-            }
-        }
-        if (found) {
-            age.has_creature = true;
-            age.min_creation_time = creation_min;
-            age.min_division_time = division_min;
-        } else {
-            age.has_creature = false;
-            age.min_creation_time = 0.0f;
-            age.min_division_time = 0.0f;
-        }
-        age.dirty = false;
-    }
-
-    if (!age.has_creature) {
-        age.max_age_since_creation = 0.0f;
-        age.max_age_since_division = 0.0f;
-        return;
+    if (new_holder) {
+        generation.brain = new_holder->get_brain();
+    } else {
+        generation.brain.reset();
     }
-
-    age.max_age_since_creation = std::max(0.0f, timing.sim_time_accum - age.min_creation_time);
-    age.max_age_since_division = std::max(0.0f, timing.sim_time_accum - age.min_division_time);
 }
 
-void Game::mark_age_dirty() {
-    age.dirty = true;
+void Game::update_max_ages() {
+    const std::optional<float> min_creation_time = age_index.min_creation_time();
+    const std::optional<float> min_division_time = age_index.min_division_time();
+    age.max_age_since_creation = min_creation_time ? std::max(0.0f, timing.sim_time_accum - *min_creation_time) : 0.0f;
+    age.max_age_since_division = min_division_time ? std::max(0.0f, timing.sim_time_accum - *min_division_time) : 0.0f;
 }
 
 void Game::mark_selection_dirty() {
@@ -518,8 +582,7 @@ const CreatureCircle* Game::find_nearest_creature(const b2Vec2& pos) const {
 
 void Game::update_creatures(const b2WorldId& worldId, float dt) {
     for (size_t i = 0; i < circles.size(); ++i) {
-        if (circles[i] && circles[i]->get_kind() == CircleKind::Creature) {
-            auto* creature_circle = static_cast<CreatureCircle*>(circles[i].get());
+        if (auto* creature_circle = circle_cast<CreatureCircle>(circles[i].get())) {
             creature_circle->process_eating(worldId, *this, death.poison_death_probability, death.poison_death_probability_normal);
             creature_circle->update_inactivity(dt, death.inactivity_timeout);
         }
@@ -527,21 +590,100 @@ void Game::update_creatures(const b2WorldId& worldId, float dt) {
 }
 
 void Game::run_brain_updates(const b2WorldId& worldId, float timeStep) {
-    (void)timeStep;
-    const float brain_period = (brain.updates_per_second > 0.0f) ? (1.0f / brain.updates_per_second) : std::numeric_limits<float>::max();
+    const float brain_hz = qos.governed_brain_hz(brain.updates_per_second);
+    const float brain_period = (brain_hz > 0.0f) ? (1.0f / brain_hz) : std::numeric_limits<float>::max();
+    const bool scheduled_mutation = mutation.live_mutation_enabled && mutation.scheduled_live_mutation;
+    const float mutation_probability = scheduled_mutation ? live_mutation_event_probability() : 0.0f;
+    if (mutation_probability != mutation.scheduled_probability) {
+        // Countdowns drawn at the old rate would be paired with the new 1 / p scaling.
+        reset_live_mutation_countdowns();
+        mutation.scheduled_probability = mutation_probability;
+    }
+    if (brain.staggered) {
+        // Each creature keeps its own phase, so about timeStep / brain_period of the
+        // population thinks on any given tick instead of everyone on the same one.
+        brain.time_accumulator = 0.0f;
+        for (size_t i = 0; i < circles.size(); ++i) {
+            if (auto* creature_circle = circle_cast<CreatureCircle>(circles[i].get())) {
+                float& accumulator = creature_circle->brain_update_accumulator();
+                accumulator += timeStep;
+                while (accumulator >= brain_period) {
+                    update_creature_brain(worldId, *creature_circle, brain_period, mutation_probability);
+                    accumulator -= brain_period;
+                }
+            }
+        }
+        return;
+    }
     while (brain.time_accumulator >= brain_period) {
         for (size_t i = 0; i < circles.size(); ++i) {
-            if (circles[i] && circles[i]->get_kind() == CircleKind::Creature) {
-                auto* creature_circle = static_cast<CreatureCircle*>(circles[i].get());
-                creature_circle->set_minimum_area(creature.minimum_area);
-                creature_circle->set_display_mode(!show_true_color);
-                creature_circle->move_intelligently(worldId, *this, brain_period);
+            if (auto* creature_circle = circle_cast<CreatureCircle>(circles[i].get())) {
+                update_creature_brain(worldId, *creature_circle, brain_period, mutation_probability);
             }
         }
         brain.time_accumulator -= brain_period;
     }
 }
 
+void Game::update_creature_brain(const b2WorldId& worldId, CreatureCircle& creature_circle, float brain_period, float mutation_probability) {
+    creature_circle.set_minimum_area(creature.minimum_area);
+    creature_circle.set_display_mode(!show_true_color);
+    creature_circle.move_intelligently(worldId, *this, brain_period);
+    if (mutation_probability > 0.0f) {
+        run_scheduled_live_mutation(creature_circle, mutation_probability);
+    }
+}
+
+// Golden-ratio steps spread successive creatures evenly over the update period
+// without drawing from the dish's random stream.
+float Game::next_brain_phase() {
+    brain.next_phase += 0.61803398875f;
+    brain.next_phase -= std::floor(brain.next_phase);
+    return brain.next_phase;
+}
+
+// Chance that a per-tick mutate() call would fire at least one of its weight, add-connection
+// or add-node events, treating each threshold as an independent per-tick probability.
+float Game::live_mutation_event_probability() const {
+    const float quiet = (1.0f - mutation.mutate_weight_thresh) *
+                        (1.0f - mutation.tick_add_connection_thresh) *
+                        (1.0f - mutation.tick_add_node_thresh);
+    return std::clamp(1.0f - quiet, 0.0f, 1.0f);
+}
+
+int Game::sample_ticks_until_live_mutation(float event_probability) {
+    if (event_probability >= 1.0f) {
+        return 0;
+    }
+    // Geometric skip: number of quiet ticks before the next event.
+    const float u = random_unit();
+    const float skip = std::floor(std::log1p(-u) / std::log1p(-event_probability));
+    return static_cast<int>(std::min(skip, static_cast<float>(std::numeric_limits<int>::max() / 2)));
+}
+
+void Game::run_scheduled_live_mutation(CreatureCircle& creature_circle, float event_probability) {
+    int& countdown = creature_circle.live_mutation_countdown();
+    if (countdown < 0) {
+        countdown = sample_ticks_until_live_mutation(event_probability);
+    }
+    if (countdown > 0) {
+        --countdown;
+        return;
+    }
+    // Conditioned on an event firing, each threshold scales by 1 / p, which keeps the
+    // long-run per-tick rates of the unscheduled mode.
+    creature_circle.apply_live_mutation(*this, 1.0f / event_probability);
+    countdown = sample_ticks_until_live_mutation(event_probability);
+}
+
+void Game::reset_live_mutation_countdowns() {
+    for (auto& circle : circles) {
+        if (auto* creature_circle = circle_cast<CreatureCircle>(circle.get())) {
+            creature_circle->live_mutation_countdown() = -1;
+        }
+    }
+}
+
 void Game::refresh_generation_and_age() {
     recompute_max_generation();
     update_max_ages();
@@ -549,8 +691,7 @@ void Game::refresh_generation_and_age() {
 
 Game::RemovalResult Game::evaluate_circle_removal(EatableCircle& circle, std::vector<std::unique_ptr<EatableCircle>>& spawned_cloud) {
     RemovalResult result{};
-    if (circle.get_kind() == CircleKind::Creature) {
-        const auto* creature_circle = static_cast<const CreatureCircle*>(&circle);
+    if (const auto* creature_circle = circle_cast<CreatureCircle>(&circle)) {
         if (creature_circle->is_poisoned()) {
             spawner.spawn_eatable_cloud(*creature_circle, spawned_cloud);
             result.should_remove = true;
@@ -616,7 +757,6 @@ void Game::cull_consumed() {
         compact_circles(state.remove_mask);
     }
     if (state.removed_creature) {
-        mark_age_dirty();
         mark_selection_dirty();
     }
 
@@ -651,7 +791,6 @@ void Game::erase_indices_descending(std::vector<std::size_t>& indices) {
 
     selection.revalidate_selection(snapshot.circle);
     if (removed_creature) {
-        mark_age_dirty();
         mark_selection_dirty();
     }
     refresh_generation_and_age();
@@ -735,7 +874,6 @@ void Game::remove_outside_petri() {
 
     selection.handle_selection_after_removal(snapshot, selected_removed, nullptr, snapshot.position);
     if (removed_creature) {
-        mark_age_dirty();
         mark_selection_dirty();
     }
     refresh_generation_and_age();
@@ -763,7 +901,6 @@ void Game::remove_random_percentage(float percentage) {
     std::vector<std::size_t> indices(circles.size());
     std::iota(indices.begin(), indices.end(), 0);
 
-    static std::mt19937 rng{std::random_device{}()};
     std::shuffle(indices.begin(), indices.end(), rng);
 
     indices.resize(target);
@@ -771,15 +908,12 @@ void Game::remove_random_percentage(float percentage) {
 }
 
 std::vector<std::size_t> Game::collect_pellet_indices(bool toxic, bool division_pellet) const {
+    const CircleKind wanted = pellet_kind_for(toxic, division_pellet);
     std::vector<std::size_t> indices;
     indices.reserve(circles.size());
     for (std::size_t i = 0; i < circles.size(); ++i) {
-        if (auto* e = dynamic_cast<const EatableCircle*>(circles[i].get())) {
-            if (e->is_boost_particle()) continue;
-            if (e->get_kind() == CircleKind::Creature) continue;
-            if (e->is_toxic() == toxic && e->is_division_pellet() == division_pellet) {
-                indices.push_back(i);
-            }
+        if (circles[i]->get_kind() == wanted) {
+            indices.push_back(i);
         }
     }
     return indices;
@@ -800,30 +934,25 @@ void Game::remove_percentage_pellets(float percentage, bool toxic, bool division
         return;
     }
 
-    static std::mt19937 rng{std::random_device{}()};
     std::shuffle(indices.begin(), indices.end(), rng);
     indices.resize(target);
     erase_indices_descending(indices);
 }
 
 std::size_t Game::count_pellets(bool toxic, bool division_pellet) const {
+    const CircleKind wanted = pellet_kind_for(toxic, division_pellet);
     std::size_t count = 0;
     const float dish_radius = dish.radius;
     for (const auto& c : circles) {
-        if (auto* e = dynamic_cast<const EatableCircle*>(c.get())) {
-            if (e->is_boost_particle()) continue;
-            if (e->get_kind() == CircleKind::Creature) continue;
-            // Only count pellets inside the petri dish.
-            b2Vec2 pos = e->getPosition();
-            float r = e->getRadius();
-            if (r >= dish_radius) continue;
-            float max_center_dist = dish_radius - r;
-            float dist2 = pos.x * pos.x + pos.y * pos.y;
-            if (dist2 > max_center_dist * max_center_dist) continue;
-            if (e->is_toxic() == toxic && e->is_division_pellet() == division_pellet) {
-                ++count;
-            }
-        }
+        if (c->get_kind() != wanted) continue;
+        // Only count pellets inside the petri dish.
+        b2Vec2 pos = c->getPosition();
+        float r = c->getRadius();
+        if (r >= dish_radius) continue;
+        float max_center_dist = dish_radius - r;
+        float dist2 = pos.x * pos.x + pos.y * pos.y;
+        if (dist2 > max_center_dist * max_center_dist) continue;
+        ++count;
     }
     return count;
 }
@@ -835,8 +964,6 @@ std::size_t Game::get_cached_pellet_count(bool toxic, bool division_pellet) cons
 
 void Game::adjust_pellet_count(const EatableCircle* circle, int delta) {
     if (!circle) return;
-    if (circle->is_boost_particle()) return;
-    if (circle->get_kind() == CircleKind::Creature) return;
 
     auto apply = [&](std::size_t& counter) {
         if (delta > 0) {
@@ -847,12 +974,20 @@ void Game::adjust_pellet_count(const EatableCircle* circle, int delta) {
         }
     };
 
-    if (circle->is_division_pellet()) {
-        apply(pellets.division_count_cached);
-    } else if (circle->is_toxic()) {
-        apply(pellets.toxic_count_cached);
-    } else {
-        apply(pellets.food_count_cached);
+    switch (circle->get_kind()) {
+        case CircleKind::DivisionPellet:
+            apply(pellets.division_count_cached);
+            break;
+        case CircleKind::ToxicPellet:
+            apply(pellets.toxic_count_cached);
+            break;
+        case CircleKind::Pellet:
+            apply(pellets.food_count_cached);
+            break;
+        case CircleKind::Creature:
+        case CircleKind::BoostParticle:
+        case CircleKind::Unknown:
+            break;
     }
 }
 
@@ -941,6 +1076,97 @@ void Game::remove_stopped_boost_particles() {
     refresh_generation_and_age();
 }
 
+void Game::settle_pushed_pellets() {
+    if (!pellets.lightweight && pellets.body_motion != CirclePhysics::BodyMotion::Static) {
+        return;
+    }
+
+    // Pellets promoted by a push go back to being bodyless (or static) once they come to rest.
+    for (auto& circle : circles) {
+        if (!is_pellet_kind(circle->get_kind()) || !circle->has_body()) {
+            continue;
+        }
+        if (pellets.lightweight) {
+            if (circle->is_at_rest()) {
+                circle->clear_touching();
+                circle->release_body();
+            }
+        } else {
+            circle->restore_body_motion();
+        }
+    }
+}
+
+void Game::update_lightweight_pellet_touches() {
+    if (!pellets.lightweight) {
+        return;
+    }
+
+    pellet_grid.rebuild(circles);
+
+    std::vector<CirclePhysics*> overlapping;
+    std::vector<CirclePhysics*> stale;
+    for (auto& circle : circles) {
+        auto* creature_circle = circle_cast<CreatureCircle>(circle.get());
+        if (!creature_circle) {
+            continue;
+        }
+        overlapping.clear();
+        pellet_grid.for_each_overlapping(creature_circle->getPosition(), creature_circle->getRadius(), [&](EatableCircle& pellet) {
+            overlapping.push_back(&pellet);
+        });
+        std::sort(overlapping.begin(), overlapping.end());
+
+        stale.clear();
+        creature_circle->for_each_touching([&](CirclePhysics& other) {
+            if (!other.has_body() && !std::binary_search(overlapping.begin(), overlapping.end(), &other)) {
+                stale.push_back(&other);
+            }
+        });
+        for (auto* other : stale) {
+            creature_circle->remove_touching_circle(other);
+            other->remove_touching_circle(creature_circle);
+        }
+        for (auto* other : overlapping) {
+            creature_circle->add_touching_circle(other);
+            other->add_touching_circle(creature_circle);
+        }
+    }
+}
+
+void Game::set_lightweight_pellets(bool enabled) {
+    if (pellets.lightweight == enabled) {
+        return;
+    }
+    pellets.lightweight = enabled;
+
+    // Touches came from the other detection path, so drop them and let the new one rediscover.
+    for (auto& circle : circles) {
+        if (!is_pellet_kind(circle->get_kind())) {
+            continue;
+        }
+        circle->clear_touching();
+        if (enabled) {
+            circle->release_body();
+        } else {
+            circle->ensure_body();
+        }
+    }
+    pellet_grid.rebuild(circles);
+}
+
+void Game::set_pellet_body_motion(CirclePhysics::BodyMotion motion) {
+    if (pellets.body_motion == motion) {
+        return;
+    }
+    pellets.body_motion = motion;
+    for (auto& circle : circles) {
+        if (is_pellet_kind(circle->get_kind())) {
+            circle->set_body_motion(motion);
+        }
+    }
+}
+
 void Game::finalize_world_state() {
     cull_consumed();
     remove_stopped_boost_particles();
@@ -951,6 +1177,176 @@ void Game::finalize_world_state() {
     apply_selection_mode();
 }
 
+std::size_t Game::get_shared_brain_count() const {
+    std::size_t count = 0;
+    for (const auto& circle : circles) {
+        if (const auto* creature = circle_cast<const CreatureCircle>(circle.get())) {
+            count += creature->is_brain_shared() ? 1 : 0;
+        }
+    }
+    return count;
+}
+
+std::size_t Game::compact_innovations() {
+    std::vector<const neat::Genome*> live_genomes;
+    for (const auto& circle : circles) {
+        if (const auto* creature = circle_cast<const CreatureCircle>(circle.get())) {
+            live_genomes.push_back(&creature->get_brain());
+        }
+    }
+    if (generation.brain) {
+        live_genomes.push_back(&(*generation.brain));
+    }
+    innovation_compaction.last_dropped = innovations.compact(live_genomes);
+    return innovation_compaction.last_dropped;
+}
+
+void Game::compact_innovations_if_due() {
+    if (innovation_compaction.interval <= 0.0f || timing.sim_time_accum < innovation_compaction.next_time) {
+        return;
+    }
+    compact_innovations();
+    innovation_compaction.next_time = timing.sim_time_accum + innovation_compaction.interval;
+}
+
+bool Game::start_telemetry(const std::string& path, float interval_seconds) {
+    auto writer = std::make_unique<telemetry::Writer>();
+    if (!writer->open(path)) {
+        return false;
+    }
+    telemetry.writer = std::move(writer);
+    telemetry.interval = std::max(0.0f, interval_seconds);
+    telemetry.next_time = timing.sim_time_accum;
+    telemetry.births = 0;
+    telemetry.arrivals = 0;
+    telemetry.creatures_at_last_sample = get_creature_count();
+    telemetry.sim_time_at_last_sample = timing.sim_time_accum;
+    telemetry.started = std::chrono::steady_clock::now();
+    telemetry.last_sample = telemetry.started;
+    return true;
+}
+
+void Game::stop_telemetry() {
+    if (telemetry.writer) {
+        telemetry.writer->close();
+        telemetry.writer.reset();
+    }
+}
+
+bool Game::start_event_trace(const std::string& path) {
+    auto recorder = std::make_unique<event_trace::Recorder>();
+    if (!recorder->open(path)) {
+        return false;
+    }
+    event_recorder = std::move(recorder);
+    return true;
+}
+
+void Game::stop_event_trace() {
+    if (event_recorder) {
+        event_recorder->close();
+        event_recorder.reset();
+    }
+}
+
+void Game::record_trace_event(event_trace::EventType type, const EatableCircle& subject, std::uint64_t other, std::uint8_t detail) {
+    const b2Vec2 position = subject.getPosition();
+    event_trace::Event event;
+    event.tick = timing.tick;
+    event.type = type;
+    event.detail = detail;
+    event.subject = subject.get_entity_id();
+    event.other = other;
+    event.x = position.x;
+    event.y = position.y;
+    event_recorder->record(event);
+}
+
+void Game::record_telemetry_if_due() {
+    if (!telemetry.writer || timing.sim_time_accum < telemetry.next_time) {
+        return;
+    }
+    telemetry.writer->append(collect_telemetry_record());
+    telemetry.next_time = timing.sim_time_accum + telemetry.interval;
+}
+
+telemetry::Record Game::collect_telemetry_record() {
+    telemetry::Record record;
+    const auto now = std::chrono::steady_clock::now();
+    const float wall_delta = std::chrono::duration<float>(now - telemetry.last_sample).count();
+    record.sim_time = timing.sim_time_accum;
+    record.wall_seconds = std::chrono::duration<float>(now - telemetry.started).count();
+    record.sim_speed = wall_delta > 0.0f ? (timing.sim_time_accum - telemetry.sim_time_at_last_sample) / wall_delta : 0.0f;
+
+    std::vector<float> areas;
+    std::size_t node_total = 0;
+    std::size_t connection_total = 0;
+    for (const auto& circle : circles) {
+        switch (circle->get_kind()) {
+            case CircleKind::Creature: {
+                const auto& creature_circle = static_cast<const CreatureCircle&>(*circle);
+                const auto& genome = creature_circle.get_brain();
+                areas.push_back(creature_circle.getArea());
+                ++record.generation_histogram[telemetry::generation_bucket(creature_circle.get_generation())];
+                node_total += genome.nodes.size();
+                connection_total += genome.connections.size();
+                record.brain_nodes_max = std::max(record.brain_nodes_max, static_cast<std::uint32_t>(genome.nodes.size()));
+                record.brain_connections_max = std::max(record.brain_connections_max, static_cast<std::uint32_t>(genome.connections.size()));
+                break;
+            }
+            case CircleKind::Pellet:
+                ++record.food_pellets;
+                break;
+            case CircleKind::ToxicPellet:
+                ++record.toxic_pellets;
+                break;
+            case CircleKind::DivisionPellet:
+                ++record.division_pellets;
+                break;
+            case CircleKind::BoostParticle:
+                ++record.boost_particles;
+                break;
+            case CircleKind::Unknown:
+                break;
+        }
+    }
+
+    const std::size_t creature_count = areas.size();
+    record.creatures = static_cast<std::uint32_t>(creature_count);
+    record.max_generation = static_cast<std::uint32_t>(std::max(0, generation.max_generation));
+    record.births = static_cast<std::uint32_t>(telemetry.births);
+    record.arrivals = static_cast<std::uint32_t>(telemetry.arrivals);
+    // Every creature that left since the last sample was either there then or added since.
+    const std::size_t before_plus_added = telemetry.creatures_at_last_sample + telemetry.births + telemetry.arrivals;
+    record.deaths = static_cast<std::uint32_t>(before_plus_added > creature_count ? before_plus_added - creature_count : 0);
+
+    if (creature_count > 0) {
+        std::sort(areas.begin(), areas.end());
+        auto quantile = [&areas](float q) {
+            return areas[static_cast<std::size_t>(q * static_cast<float>(areas.size() - 1) + 0.5f)];
+        };
+        record.area_min = areas.front();
+        record.area_p25 = quantile(0.25f);
+        record.area_median = quantile(0.5f);
+        record.area_p75 = quantile(0.75f);
+        record.area_max = areas.back();
+        record.area_mean = std::accumulate(areas.begin(), areas.end(), 0.0f) / static_cast<float>(creature_count);
+        record.brain_nodes_mean = static_cast<float>(node_total) / static_cast<float>(creature_count);
+        record.brain_connections_mean = static_cast<float>(connection_total) / static_cast<float>(creature_count);
+    }
+
+    const physics_allocator::Stats physics_memory = physics_allocator::get_stats();
+    record.physics_kib = static_cast<std::uint32_t>(physics_memory.current_bytes >> 10);
+    record.physics_peak_kib = static_cast<std::uint32_t>(physics_memory.peak_bytes >> 10);
+
+    telemetry.births = 0;
+    telemetry.arrivals = 0;
+    telemetry.creatures_at_last_sample = creature_count;
+    telemetry.sim_time_at_last_sample = timing.sim_time_accum;
+    telemetry.last_sample = now;
+    return record;
+}
+
 void Game::accumulate_real_time(float dt) {
     if (dt <= 0.0f) return;
     timing.last_real_dt = dt;
@@ -0,0 +1,109 @@
+#include "game/age_index.hpp"
+
+#include "creature_circle.hpp"
+
+bool AgeIndex::OldestThenLargest::operator()(const CreatureCircle* a, const CreatureCircle* b) const {
+    if (a->get_creation_time() != b->get_creation_time()) {
+        return a->get_creation_time() < b->get_creation_time();
+    }
+    return a->getArea() > b->getArea();
+}
+
+bool AgeIndex::OldestThenSmallest::operator()(const CreatureCircle* a, const CreatureCircle* b) const {
+    if (a->get_creation_time() != b->get_creation_time()) {
+        return a->get_creation_time() < b->get_creation_time();
+    }
+    return a->getArea() < b->getArea();
+}
+
+bool AgeIndex::EarliestDivision::operator()(const CreatureCircle* a, const CreatureCircle* b) const {
+    return a->get_last_division_time() < b->get_last_division_time();
+}
+
+void AgeIndex::insert(const CreatureCircle& creature) {
+    by_age_largest.push(&creature);
+    by_age_smallest.push(&creature);
+    by_division.push(&creature);
+    erase_by_area(creature);
+    insert_by_area(creature);
+}
+
+void AgeIndex::erase(const CreatureCircle& creature) {
+    by_age_largest.erase(&creature);
+    by_age_smallest.erase(&creature);
+    by_division.erase(&creature);
+    erase_by_area(creature);
+}
+
+void AgeIndex::on_times_changed(const CreatureCircle& creature) {
+    if (!indexed_keys.count(&creature)) {
+        return;
+    }
+    by_age_largest.update(&creature);
+    by_age_smallest.update(&creature);
+    by_division.update(&creature);
+    erase_by_area(creature);
+    insert_by_area(creature);
+}
+
+void AgeIndex::on_area_changed(const CreatureCircle& creature) {
+    if (!indexed_keys.count(&creature)) {
+        return;
+    }
+    by_age_largest.update(&creature);
+    by_age_smallest.update(&creature);
+    erase_by_area(creature);
+    insert_by_area(creature);
+}
+
+void AgeIndex::clear() {
+    by_age_largest.clear();
+    by_age_smallest.clear();
+    by_division.clear();
+    area_by_age.clear();
+    indexed_keys.clear();
+}
+
+const CreatureCircle* AgeIndex::oldest_median() const {
+    if (area_by_age.empty()) {
+        return nullptr;
+    }
+    const auto& oldest = area_by_age.begin()->second;
+    const AreaKey* median = oldest.kth(oldest.size() / 2);
+    return median ? median->second : nullptr;
+}
+
+void AgeIndex::insert_by_area(const CreatureCircle& creature) {
+    const IndexedKey key{creature.get_creation_time(), creature.getArea()};
+    indexed_keys[&creature] = key;
+    area_by_age[key.creation_time].insert(AreaKey{key.area, &creature});
+}
+
+void AgeIndex::erase_by_area(const CreatureCircle& creature) {
+    auto it = indexed_keys.find(&creature);
+    if (it == indexed_keys.end()) {
+        return;
+    }
+    auto bucket = area_by_age.find(it->second.creation_time);
+    if (bucket != area_by_age.end()) {
+        bucket->second.erase(AreaKey{it->second.area, &creature});
+        if (bucket->second.empty()) {
+            area_by_age.erase(bucket);
+        }
+    }
+    indexed_keys.erase(it);
+}
+
+std::optional<float> AgeIndex::min_creation_time() const {
+    if (const CreatureCircle* oldest = by_age_largest.top()) {
+        return oldest->get_creation_time();
+    }
+    return std::nullopt;
+}
+
+std::optional<float> AgeIndex::min_division_time() const {
+    if (const CreatureCircle* earliest = by_division.top()) {
+        return earliest->get_last_division_time();
+    }
+    return std::nullopt;
+}
@@ -0,0 +1,22 @@
+#include "game/genome_pool.hpp"
+
+#include <utility>
+
+neat::Genome GenomePool::acquire_copy(const neat::Genome& source) {
+    if (pooled.empty()) {
+        return source;
+    }
+    neat::Genome genome = std::move(pooled.back());
+    pooled.pop_back();
+    // Copy-assignment keeps the recycled vectors' capacity when it is already large enough.
+    genome = source;
+    ++reuse_count;
+    return genome;
+}
+
+void GenomePool::release(neat::Genome&& genome) {
+    if (!accepting || pooled.size() >= max_pooled) {
+        return;
+    }
+    pooled.push_back(std::move(genome));
+}
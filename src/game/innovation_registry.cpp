@@ -0,0 +1,190 @@
+#include "game/innovation_registry.hpp"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace {
+constexpr std::size_t MIN_SHARD_CAPACITY = 64;
+
+void set_scratch_id(std::vector<std::vector<int>>& table, int in_node, int out_node, int id) {
+    if (in_node < 0 || out_node < 0) {
+        return;
+    }
+    const auto in_index = static_cast<std::size_t>(in_node);
+    const auto out_index = static_cast<std::size_t>(out_node);
+    if (table.size() <= in_index) {
+        table.resize(in_index + 1);
+    }
+    auto& row = table[in_index];
+    if (row.size() <= out_index) {
+        row.resize(out_index + 1, -1);
+    }
+    row[out_index] = id;
+}
+
+std::size_t next_power_of_two(std::size_t n) {
+    std::size_t capacity = MIN_SHARD_CAPACITY;
+    while (capacity < n) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+} // namespace
+
+std::uint64_t InnovationRegistry::make_key(int in_node, int out_node) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(in_node)) << 32) |
+           static_cast<std::uint32_t>(out_node);
+}
+
+std::uint64_t InnovationRegistry::hash_key(std::uint64_t key) {
+    // splitmix64 finaliser: neighbouring node pairs land far apart.
+    key ^= key >> 30;
+    key *= 0xBF58476D1CE4E5B9ull;
+    key ^= key >> 27;
+    key *= 0x94D049BB133111EBull;
+    key ^= key >> 31;
+    return key;
+}
+
+InnovationRegistry::Shard& InnovationRegistry::shard_for(std::uint64_t hash) {
+    // Top bits pick the shard, low bits the slot inside it.
+    return shards[static_cast<std::size_t>(hash >> 60) % SHARD_COUNT];
+}
+
+InnovationRegistry::Slot* InnovationRegistry::Shard::find_slot(std::uint64_t key, std::uint64_t hash) {
+    const std::size_t mask = slots.size() - 1;
+    for (std::size_t i = static_cast<std::size_t>(hash) & mask;; i = (i + 1) & mask) {
+        Slot& slot = slots[i];
+        if (slot.key == key || slot.key == EMPTY_KEY) {
+            return &slot;
+        }
+    }
+}
+
+void InnovationRegistry::Shard::grow(std::size_t min_capacity) {
+    std::vector<Slot> old = std::move(slots);
+    slots.assign(next_power_of_two(min_capacity), Slot{});
+    for (const Slot& slot : old) {
+        if (slot.key != EMPTY_KEY) {
+            *find_slot(slot.key, hash_key(slot.key)) = slot;
+        }
+    }
+}
+
+int InnovationRegistry::lookup_or_assign(int in_node, int out_node) {
+    const std::uint64_t key = make_key(in_node, out_node);
+    const std::uint64_t hash = hash_key(key);
+    Shard& shard = shard_for(hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    // Keep the load factor under 3/4 so probe runs stay short.
+    if ((shard.count + 1) * 4 > shard.slots.size() * 3) {
+        shard.grow(shard.slots.size() * 2);
+    }
+    Slot* slot = shard.find_slot(key, hash);
+    if (slot->key == EMPTY_KEY) {
+        slot->key = key;
+        slot->id = last_innovation_id.fetch_add(1, std::memory_order_relaxed) + 1;
+        ++shard.count;
+    }
+    return slot->id;
+}
+
+void InnovationRegistry::reconcile(neat::Genome& genome) {
+    for (auto& connection : genome.connections) {
+        connection.innovId = lookup_or_assign(connection.inNodeId, connection.outNodeId);
+    }
+}
+
+std::mutex& InnovationRegistry::library_mutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+void InnovationRegistry::reconcile_new(neat::Genome& genome, int placeholder_floor) {
+    for (auto& connection : genome.connections) {
+        if (connection.innovId > placeholder_floor) {
+            connection.innovId = lookup_or_assign(connection.inNodeId, connection.outNodeId);
+        }
+    }
+}
+
+neat::Genome InnovationRegistry::create_genome(int input_count, int output_count, float weight_extremum_init) {
+    std::lock_guard<std::mutex> lock(library_mutex());
+    ScratchTable& scratch = prepare_scratch(nullptr);
+    neat::Genome genome(input_count, output_count, &scratch.table, &scratch.last_id, weight_extremum_init);
+    reconcile(genome);
+    return genome;
+}
+
+std::size_t InnovationRegistry::compact(const std::vector<const neat::Genome*>& live_genomes) {
+    std::array<std::vector<std::uint64_t>, SHARD_COUNT> live_keys;
+    for (const neat::Genome* genome : live_genomes) {
+        for (const auto& connection : genome->connections) {
+            const std::uint64_t key = make_key(connection.inNodeId, connection.outNodeId);
+            live_keys[static_cast<std::size_t>(hash_key(key) >> 60) % SHARD_COUNT].push_back(key);
+        }
+    }
+
+    std::size_t dropped = 0;
+    for (std::size_t s = 0; s < SHARD_COUNT; ++s) {
+        auto& keys = live_keys[s];
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+        Shard& shard = shards[s];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.count == 0) {
+            continue;
+        }
+        std::vector<Slot> kept;
+        kept.reserve(keys.size());
+        for (std::uint64_t key : keys) {
+            const Slot* slot = shard.find_slot(key, hash_key(key));
+            if (slot->key == key) {
+                kept.push_back(*slot);
+            }
+        }
+        dropped += shard.count - kept.size();
+        // assign() would keep the old capacity; a fresh table actually returns the memory.
+        std::vector<Slot>(next_power_of_two(kept.size() * 2), Slot{}).swap(shard.slots);
+        shard.count = kept.size();
+        for (const Slot& slot : kept) {
+            *shard.find_slot(slot.key, hash_key(slot.key)) = slot;
+        }
+    }
+    return dropped;
+}
+
+std::size_t InnovationRegistry::size() const {
+    std::size_t total = 0;
+    for (const auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        total += shard.count;
+    }
+    return total;
+}
+
+std::size_t InnovationRegistry::memory_bytes() const {
+    std::size_t total = 0;
+    for (const auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        total += shard.slots.capacity() * sizeof(Slot);
+    }
+    return total;
+}
+
+InnovationRegistry::ScratchTable& InnovationRegistry::prepare_scratch(const neat::Genome* genome) {
+    thread_local ScratchTable scratch;
+    for (auto& row : scratch.table) {
+        row.clear();
+    }
+    // Ids handed out by the scratch table are placeholders until reconcile(); start them
+    // past the registry so they never alias a real id while the genome is mid-mutation.
+    scratch.last_id = get_last_id();
+    if (genome) {
+        for (const auto& connection : genome->connections) {
+            set_scratch_id(scratch.table, connection.inNodeId, connection.outNodeId, connection.innovId);
+        }
+    }
+    return scratch;
+}
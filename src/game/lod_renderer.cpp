@@ -0,0 +1,176 @@
+#include "game/lod_renderer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "eatable_circle.hpp"
+
+namespace {
+constexpr float FULL_DETAIL_MIN_PIXELS = 8.0f;
+constexpr float COARSE_MAX_PIXELS = 3.0f;
+constexpr float DENSITY_MAX_PIXELS = 1.0f;
+// Small creatures are drawn at least this large so they never vanish between pixels.
+constexpr float MIN_VISIBLE_PIXELS = 0.75f;
+constexpr unsigned int DENSITY_TEXEL_PIXELS = 2;
+constexpr float PI = 3.14159265358979f;
+
+template <std::size_t Segments>
+const std::array<sf::Vector2f, Segments + 1>& unit_circle() {
+    static const auto table = [] {
+        std::array<sf::Vector2f, Segments + 1> points{};
+        for (std::size_t i = 0; i <= Segments; ++i) {
+            const float angle = 2.0f * PI * static_cast<float>(i) / static_cast<float>(Segments);
+            points[i] = sf::Vector2f{std::cos(angle), std::sin(angle)};
+        }
+        return points;
+    }();
+    return table;
+}
+} // namespace
+
+void LodRenderer::begin(const sf::RenderTarget& target) {
+    stats = {};
+    for (Layer* layer : {&background, &creatures}) {
+        layer->full_detail.clear();
+        layer->low_detail.clear();
+    }
+
+    const sf::View& view = target.getView();
+    view_rect = sf::FloatRect{view.getCenter() - view.getSize() / 2.0f, view.getSize()};
+    const sf::Vector2u target_size = target.getSize();
+    pixels_per_unit = view_rect.size.x > 0.0f ? static_cast<float>(target_size.x) / view_rect.size.x : 1.0f;
+
+    // The density layer is an axis-aligned sprite over the view, so rotated views skip it.
+    density_enabled = view.getRotation().asDegrees() == 0.0f && view_rect.size.x > 0.0f;
+    if (!density_enabled) {
+        return;
+    }
+    const sf::Vector2u wanted{
+        std::max(1u, target_size.x / DENSITY_TEXEL_PIXELS),
+        std::max(1u, target_size.y / DENSITY_TEXEL_PIXELS)};
+    if (!(wanted == density_size)) {
+        if (!density_texture.resize(wanted)) {
+            density_size = {0, 0};
+            density_enabled = false;
+            return;
+        }
+        density_texture.setSmooth(true);
+        density_size = wanted;
+        const std::size_t texel_count = static_cast<std::size_t>(wanted.x) * wanted.y;
+        density.assign(texel_count, DensityTexel{});
+        density_pixels.assign(texel_count * 4, 0);
+        touched_texels.clear();
+    }
+    texels_per_unit = static_cast<float>(density_size.x) / view_rect.size.x;
+}
+
+void LodRenderer::submit(const DrawableCircle& circle) {
+    const float radius = circle.getRadius();
+    const float radius_px = radius * pixels_per_unit;
+    const bool creature = circle.get_kind() == CircleKind::Creature;
+    Layer& layer = creature ? creatures : background;
+    if (radius_px >= FULL_DETAIL_MIN_PIXELS) {
+        layer.full_detail.push_back(&circle);
+        ++stats.full;
+        return;
+    }
+
+    const b2Vec2 position = circle.getPosition();
+    const sf::Vector2f center{position.x, position.y};
+    const sf::Color color = circle.get_fill_color();
+    if (density_enabled && radius_px < DENSITY_MAX_PIXELS && is_pellet_kind(circle.get_kind())) {
+        splat_density(center, radius, color);
+        ++stats.density;
+        return;
+    }
+
+    const float drawn_radius = std::max(radius, MIN_VISIBLE_PIXELS / pixels_per_unit);
+    append_polygon(layer.low_detail, center, drawn_radius, color, radius_px < COARSE_MAX_PIXELS ? 6 : 12);
+    if (creature) {
+        append_heading(layer.low_detail, center, drawn_radius, circle.getAngle());
+    }
+    ++stats.low_detail;
+}
+
+void LodRenderer::finish(sf::RenderTarget& target) {
+    if (density_enabled && !touched_texels.empty()) {
+        upload_density();
+        sf::Sprite sprite(density_texture);
+        sprite.setPosition(view_rect.position);
+        sprite.setScale({1.0f / texels_per_unit, 1.0f / texels_per_unit});
+        target.draw(sprite);
+    }
+    for (const Layer* layer : {&background, &creatures}) {
+        if (layer->low_detail.getVertexCount() > 0) {
+            target.draw(layer->low_detail);
+        }
+        for (const DrawableCircle* circle : layer->full_detail) {
+            circle->draw(target);
+        }
+    }
+}
+
+void LodRenderer::append_polygon(sf::VertexArray& mesh, sf::Vector2f center, float radius, sf::Color color, int segments) {
+    auto append_fan = [&](const auto& points) {
+        for (std::size_t i = 0; i + 1 < points.size(); ++i) {
+            mesh.append(sf::Vertex{center, color, {}});
+            mesh.append(sf::Vertex{center + points[i] * radius, color, {}});
+            mesh.append(sf::Vertex{center + points[i + 1] * radius, color, {}});
+        }
+    };
+    if (segments <= 6) {
+        append_fan(unit_circle<6>());
+    } else {
+        append_fan(unit_circle<12>());
+    }
+}
+
+// A white wedge from the centre to the rim, standing in for the full shape's heading line.
+void LodRenderer::append_heading(sf::VertexArray& mesh, sf::Vector2f center, float radius, float angle) {
+    const sf::Vector2f direction{std::cos(angle), std::sin(angle)};
+    const sf::Vector2f side = sf::Vector2f{-direction.y, direction.x} * (radius * 0.125f);
+    mesh.append(sf::Vertex{center + side, sf::Color::White, {}});
+    mesh.append(sf::Vertex{center - side, sf::Color::White, {}});
+    mesh.append(sf::Vertex{center + direction * radius, sf::Color::White, {}});
+}
+
+void LodRenderer::splat_density(sf::Vector2f center, float radius, sf::Color color) {
+    const float tx = (center.x - view_rect.position.x) * texels_per_unit;
+    const float ty = (center.y - view_rect.position.y) * texels_per_unit;
+    if (tx < 0.0f || ty < 0.0f || tx >= static_cast<float>(density_size.x) || ty >= static_cast<float>(density_size.y)) {
+        return;
+    }
+    const auto index = static_cast<std::uint32_t>(static_cast<std::size_t>(ty) * density_size.x + static_cast<std::size_t>(tx));
+    DensityTexel& texel = density[index];
+    if (texel.coverage == 0.0f) {
+        touched_texels.push_back(index);
+    }
+    // Coverage is the fraction of the texel the pellet's disc would fill.
+    const float radius_texels = radius * texels_per_unit;
+    const float coverage = PI * radius_texels * radius_texels;
+    texel.r += static_cast<float>(color.r) * coverage;
+    texel.g += static_cast<float>(color.g) * coverage;
+    texel.b += static_cast<float>(color.b) * coverage;
+    texel.coverage += coverage;
+}
+
+void LodRenderer::upload_density() {
+    for (std::uint32_t index : touched_texels) {
+        const DensityTexel& texel = density[index];
+        std::uint8_t* pixel = &density_pixels[static_cast<std::size_t>(index) * 4];
+        const float inverse = 1.0f / texel.coverage;
+        pixel[0] = static_cast<std::uint8_t>(std::min(texel.r * inverse, 255.0f));
+        pixel[1] = static_cast<std::uint8_t>(std::min(texel.g * inverse, 255.0f));
+        pixel[2] = static_cast<std::uint8_t>(std::min(texel.b * inverse, 255.0f));
+        pixel[3] = static_cast<std::uint8_t>(std::min(texel.coverage, 1.0f) * 255.0f);
+    }
+    density_texture.update(density_pixels.data());
+
+    // Only touched texels are non-zero, so clearing them readies the buffers for the next frame.
+    for (std::uint32_t index : touched_texels) {
+        density[index] = DensityTexel{};
+        std::fill_n(&density_pixels[static_cast<std::size_t>(index) * 4], 4, std::uint8_t{0});
+    }
+    touched_texels.clear();
+}
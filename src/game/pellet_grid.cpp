@@ -0,0 +1,75 @@
+#include "game/pellet_grid.hpp"
+
+#include <cmath>
+#include <limits>
+
+#include "eatable_circle.hpp"
+
+namespace {
+constexpr float MIN_CELL_SIZE = 0.25f;
+constexpr std::size_t MAX_CELLS = 1u << 18;
+} // namespace
+
+void PelletGrid::rebuild(const std::vector<std::unique_ptr<EatableCircle>>& circles) {
+    scratch.clear();
+    max_radius = 0.0f;
+    float min_x = std::numeric_limits<float>::max();
+    float min_y = std::numeric_limits<float>::max();
+    float max_x = std::numeric_limits<float>::lowest();
+    float max_y = std::numeric_limits<float>::lowest();
+
+    for (const auto& circle : circles) {
+        if (!is_pellet_kind(circle->get_kind()) || circle->has_body() || circle->is_eaten()) {
+            continue;
+        }
+        const b2Vec2 pos = circle->getPosition();
+        const float r = circle->getRadius();
+        scratch.push_back(Entry{pos.x, pos.y, r, circle.get()});
+        max_radius = std::max(max_radius, r);
+        min_x = std::min(min_x, pos.x);
+        min_y = std::min(min_y, pos.y);
+        max_x = std::max(max_x, pos.x);
+        max_y = std::max(max_y, pos.y);
+    }
+
+    entries.clear();
+    if (scratch.empty()) {
+        columns = 0;
+        rows = 0;
+        return;
+    }
+
+    // Cells twice the largest pellet radius keep each query to a handful of cells.
+    float cell_size = std::max(2.0f * max_radius, MIN_CELL_SIZE);
+    const float extent_x = max_x - min_x;
+    const float extent_y = max_y - min_y;
+    while ((std::floor(extent_x / cell_size) + 1.0f) * (std::floor(extent_y / cell_size) + 1.0f) > static_cast<float>(MAX_CELLS)) {
+        cell_size *= 2.0f;
+    }
+    inverse_cell_size = 1.0f / cell_size;
+    origin_x = min_x;
+    origin_y = min_y;
+    columns = static_cast<int>(extent_x * inverse_cell_size) + 1;
+    rows = static_cast<int>(extent_y * inverse_cell_size) + 1;
+
+    const std::size_t cell_count = static_cast<std::size_t>(columns) * static_cast<std::size_t>(rows);
+    cell_start.assign(cell_count + 1, 0);
+    entry_cells.resize(scratch.size());
+    for (std::size_t i = 0; i < scratch.size(); ++i) {
+        const int cx = std::min(cell_coord_x(scratch[i].x), columns - 1);
+        const int cy = std::min(cell_coord_y(scratch[i].y), rows - 1);
+        const auto cell = static_cast<std::uint32_t>(cy * columns + cx);
+        entry_cells[i] = cell;
+        ++cell_start[cell + 1];
+    }
+    for (std::size_t c = 0; c < cell_count; ++c) {
+        cell_start[c + 1] += cell_start[c];
+    }
+
+    // Counting sort into cell order so every cell is a contiguous run of entries.
+    entries.resize(scratch.size());
+    cell_fill.assign(cell_start.begin(), cell_start.end() - 1);
+    for (std::size_t i = 0; i < scratch.size(); ++i) {
+        entries[cell_fill[entry_cells[i]]++] = scratch[i];
+    }
+}
@@ -0,0 +1,114 @@
+#include "game/qos_governor.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#include "game.hpp"
+
+namespace {
+constexpr int EVALUATION_TICKS = 120;
+constexpr float EVALUATION_WALL_SECONDS = 1.0f;
+// Restore only once ticks fit well inside the budget, so levels do not flap.
+constexpr float RESTORE_FRACTION = 0.6f;
+constexpr int BRAIN_LEVELS = 4;
+constexpr int SPRINKLE_LEVELS = 4;
+constexpr int CAP_START_LEVEL = BRAIN_LEVELS + SPRINKLE_LEVELS + 1;
+constexpr int MAX_LEVEL = CAP_START_LEVEL + 3;
+constexpr float STEP_FACTOR = 0.75f;
+constexpr float CAP_STEP_FACTOR = 0.9f;
+constexpr std::size_t HISTORY_LIMIT = 64;
+} // namespace
+
+QosGovernor::QosGovernor(Game& game_ref)
+    : game(game_ref) {}
+
+void QosGovernor::set_enabled(bool enabled) {
+    if (settings.enabled == enabled) {
+        return;
+    }
+    if (!enabled && level > 0) {
+        change_level(0, last_tick_cost, last_budget);
+    }
+    settings.enabled = enabled;
+    window_cost = 0.0f;
+    window_sim = 0.0f;
+    window_ticks = 0;
+}
+
+float QosGovernor::governed_brain_hz(float requested) const {
+    if (brain_scale >= 1.0f) {
+        return requested;
+    }
+    return std::max(requested * brain_scale, std::min(settings.min_brain_hz, requested));
+}
+
+void QosGovernor::record_tick(float wall_seconds, float sim_seconds) {
+    if (!settings.enabled) {
+        return;
+    }
+    window_cost += wall_seconds;
+    window_sim += sim_seconds;
+    ++window_ticks;
+    if (window_ticks >= EVALUATION_TICKS || window_cost >= EVALUATION_WALL_SECONDS) {
+        evaluate();
+        window_cost = 0.0f;
+        window_sim = 0.0f;
+        window_ticks = 0;
+    }
+}
+
+std::vector<std::string> QosGovernor::take_pending_log() {
+    std::vector<std::string> taken;
+    taken.swap(pending_log);
+    return taken;
+}
+
+void QosGovernor::evaluate() {
+    const float speed = settings.target_speed > 0.0f ? settings.target_speed : game.get_time_scale();
+    if (window_ticks == 0 || speed <= 0.0f) {
+        return;
+    }
+    const float tick_cost = window_cost / static_cast<float>(window_ticks);
+    const float budget = (window_sim / static_cast<float>(window_ticks)) / speed;
+    last_tick_cost = tick_cost;
+    last_budget = budget;
+    if (tick_cost > budget && level < MAX_LEVEL) {
+        change_level(level + 1, tick_cost, budget);
+    } else if (tick_cost < budget * RESTORE_FRACTION && level > 0) {
+        change_level(level - 1, tick_cost, budget);
+    }
+}
+
+void QosGovernor::change_level(int new_level, float tick_cost, float budget) {
+    if (new_level >= CAP_START_LEVEL && level < CAP_START_LEVEL) {
+        cap_anchor = game.get_age_index().size();
+    }
+    const int previous = level;
+    level = new_level;
+    apply_level();
+
+    char line[256];
+    std::snprintf(line, sizeof(line),
+                  "t=%.1fs qos level %d -> %d (tick %.2f ms, budget %.2f ms): brain %.2f Hz, food sprinkle %.2f/s, creature cap %zu",
+                  game.get_sim_time(), previous, level, tick_cost * 1000.0f, budget * 1000.0f,
+                  governed_brain_hz(game.get_brain_updates_per_sim_second()),
+                  governed_sprinkle_rate(game.get_sprinkle_rate_eatable()), soft_cap);
+    pending_log.emplace_back(line);
+    history.emplace_back(line);
+    if (history.size() > HISTORY_LIMIT) {
+        history.pop_front();
+    }
+}
+
+void QosGovernor::apply_level() {
+    brain_scale = std::pow(STEP_FACTOR, static_cast<float>(std::min(level, BRAIN_LEVELS)));
+    sprinkle_scale = std::pow(STEP_FACTOR, static_cast<float>(std::clamp(level - BRAIN_LEVELS, 0, SPRINKLE_LEVELS)));
+
+    if (level >= CAP_START_LEVEL) {
+        const float cap_scale = std::pow(CAP_STEP_FACTOR, static_cast<float>(level - CAP_START_LEVEL));
+        soft_cap = std::max<std::size_t>(1, static_cast<std::size_t>(static_cast<float>(cap_anchor) * cap_scale));
+    } else {
+        soft_cap = 0;
+    }
+}
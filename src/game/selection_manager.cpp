@@ -6,9 +6,10 @@
 
 #include "creature_circle.hpp"
 #include "eatable_circle.hpp"
+#include "game/age_index.hpp"
 
-SelectionManager::SelectionManager(std::vector<std::unique_ptr<EatableCircle>>& circles, float& sim_time_accum)
-    : circles(&circles), sim_time(&sim_time_accum) {}
+SelectionManager::SelectionManager(std::vector<std::unique_ptr<EatableCircle>>& circles, float& sim_time_accum, const AgeIndex& ages)
+    : circles(&circles), sim_time(&sim_time_accum), ages(&ages) {}
 
 void SelectionManager::clear() {
     selected_index.reset();
@@ -39,8 +40,7 @@ const neat::Genome* SelectionManager::get_selected_brain() const {
         return nullptr;
     }
     const auto* base = (*circles)[*selected_index].get();
-    if (base && base->get_kind() == CircleKind::Creature) {
-        const auto* creature = static_cast<const CreatureCircle*>(base);
+    if (const auto* creature = circle_cast<CreatureCircle>(base)) {
         return &creature->get_brain();
     }
     return nullptr;
@@ -50,79 +50,20 @@ const CreatureCircle* SelectionManager::get_selected_creature() const {
     if (!circles || !selected_index || *selected_index >= circles->size()) {
         return nullptr;
     }
-    const auto* base = (*circles)[*selected_index].get();
-    if (base && base->get_kind() == CircleKind::Creature) {
-        return static_cast<const CreatureCircle*>(base);
-    }
-    return nullptr;
+    return circle_cast<CreatureCircle>((*circles)[*selected_index].get());
 }
 
 const CreatureCircle* SelectionManager::get_oldest_largest_creature() const {
-    if (!circles || !sim_time) return nullptr;
-    const CreatureCircle* best = nullptr;
-    float best_age = -1.0f;
-    float best_area = -1.0f;
-    for (const auto& c : *circles) {
-        if (c && c->get_kind() == CircleKind::Creature) {
-            auto* creature = static_cast<const CreatureCircle*>(c.get());
-            float age = std::max(0.0f, *sim_time - creature->get_creation_time());
-            float area = creature->getArea();
-            if (age > best_age || (std::abs(age - best_age) < 1e-6f && area > best_area)) {
-                best = creature;
-                best_age = age;
-                best_area = area;
-            }
-        }
-    }
-    return best;
+    return ages ? ages->oldest_largest() : nullptr;
 }
 
 const CreatureCircle* SelectionManager::get_oldest_smallest_creature() const {
-    if (!circles || !sim_time) return nullptr;
-    const CreatureCircle* best = nullptr;
-    float best_age = -1.0f;
-    float best_area = std::numeric_limits<float>::max();
-    constexpr float eps = 1e-6f;
-    for (const auto& c : *circles) {
-        if (c && c->get_kind() == CircleKind::Creature) {
-            auto* creature = static_cast<const CreatureCircle*>(c.get());
-            float age = std::max(0.0f, *sim_time - creature->get_creation_time());
-            float area = creature->getArea();
-            if (age > best_age + eps || (std::abs(age - best_age) <= eps && area < best_area)) {
-                best_age = age;
-                best_area = area;
-                best = creature;
-            }
-        }
-    }
-    return best;
+    return ages ? ages->oldest_smallest() : nullptr;
 }
 
-#ifndef NDEBUG
 const CreatureCircle* SelectionManager::get_oldest_middle_creature() const {
-    if (!circles || !sim_time) return nullptr;
-    std::vector<std::pair<float, const CreatureCircle*>> candidates;
-    float best_age = -1.0f;
-    constexpr float eps = 1e-6f;
-    for (const auto& c : *circles) {
-        if (c && c->get_kind() == CircleKind::Creature) {
-            auto* creature = static_cast<const CreatureCircle*>(c.get());
-            float age = std::max(0.0f, *sim_time - creature->get_creation_time());
-            float area = creature->getArea();
-            if (age > best_age + eps) {
-                best_age = age;
-                candidates.clear();
-                candidates.emplace_back(area, creature);
-            } else if (std::abs(age - best_age) <= eps) {
-                candidates.emplace_back(area, creature);
-            }
-        }
-    }
-    if (candidates.empty()) return nullptr;
-    std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
-    return candidates[candidates.size() / 2].second;
+    return ages ? ages->oldest_median() : nullptr;
 }
-#endif
 
 const CreatureCircle* SelectionManager::get_follow_target_creature() const {
     if (follow_selected) {
@@ -135,9 +76,8 @@ int SelectionManager::get_selected_generation() const {
     if (!circles || !selected_index || *selected_index >= circles->size()) {
         return -1;
     }
-    const auto* base = (*circles)[*selected_index].get();
-    if (base && base->get_kind() == CircleKind::Creature) {
-        return static_cast<const CreatureCircle*>(base)->get_generation();
+    if (const auto* creature = circle_cast<CreatureCircle>((*circles)[*selected_index].get())) {
+        return creature->get_generation();
     }
     return -1;
 }
@@ -199,8 +139,7 @@ const CreatureCircle* SelectionManager::find_nearest_creature(const b2Vec2& pos)
     const CreatureCircle* best = nullptr;
     float best_dist2 = std::numeric_limits<float>::max();
     for (const auto& c : *circles) {
-        if (c && c->get_kind() == CircleKind::Creature) {
-            auto* creature = static_cast<const CreatureCircle*>(c.get());
+        if (const auto* creature = circle_cast<CreatureCircle>(c.get())) {
             b2Vec2 p = creature->getPosition();
             float dx = p.x - pos.x;
             float dy = p.y - pos.y;
@@ -2,9 +2,7 @@
 
 #include <algorithm>
 #include <cmath>
-#include <cstdlib>
 #include <limits>
-#include <random>
 
 #include "creature_circle.hpp"
 #include "game.hpp"
@@ -12,10 +10,6 @@
 namespace {
 constexpr float PI = 3.14159f;
 
-inline float random_unit() {
-    return static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX);
-}
-
 inline float radius_from_area(float area) {
     return std::sqrt(std::max(area, 0.0f) / PI);
 }
@@ -119,9 +113,10 @@ void Spawner::reset_add_drag_state() {
 
 void Spawner::sprinkle_entities(float dt) {
     ensure_minimum_creatures();
-    sprinkle_with_rate(game.get_sprinkle_rate_eatable(), static_cast<int>(Game::AddType::FoodPellet), dt);
-    sprinkle_with_rate(game.get_sprinkle_rate_toxic(), static_cast<int>(Game::AddType::ToxicPellet), dt);
-    sprinkle_with_rate(game.get_sprinkle_rate_division(), static_cast<int>(Game::AddType::DivisionPellet), dt);
+    const QosGovernor& qos = game.get_qos_governor();
+    sprinkle_with_rate(qos.governed_sprinkle_rate(game.get_sprinkle_rate_eatable()), static_cast<int>(Game::AddType::FoodPellet), dt);
+    sprinkle_with_rate(qos.governed_sprinkle_rate(game.get_sprinkle_rate_toxic()), static_cast<int>(Game::AddType::ToxicPellet), dt);
+    sprinkle_with_rate(qos.governed_sprinkle_rate(game.get_sprinkle_rate_division()), static_cast<int>(Game::AddType::DivisionPellet), dt);
 }
 
 void Spawner::ensure_minimum_creatures() {
@@ -140,17 +135,16 @@ void Spawner::ensure_minimum_creatures() {
 }
 
 b2Vec2 Spawner::random_point_in_petri() const {
-    float angle = random_unit() * 2.0f * PI;
-    float radius = game.get_petri_radius() * std::sqrt(random_unit());
+    float angle = game.random_unit() * 2.0f * PI;
+    float radius = game.get_petri_radius() * std::sqrt(game.random_unit());
     return b2Vec2{radius * std::cos(angle), radius * std::sin(angle)};
 }
 
-std::unique_ptr<CreatureCircle> Spawner::create_creature_at(const b2Vec2& pos) {
+std::unique_ptr<CreatureCircle> Spawner::create_creature_at(const b2Vec2& pos, const neat::Genome* base_brain) {
     float base_area = std::max(game.get_average_creature_area(), 0.0001f);
     float varied_area = base_area;
     float radius = radius_from_area(varied_area);
-    float angle = random_unit() * 2.0f * PI;
-    const neat::Genome* base_brain = nullptr;
+    float angle = game.random_unit() * 2.0f * PI;
     auto circle = std::make_unique<CreatureCircle>(
         game.worldId,
         pos.x,
@@ -159,12 +153,11 @@ std::unique_ptr<CreatureCircle> Spawner::create_creature_at(const b2Vec2& pos) {
         game.get_circle_density(),
         angle,
         0,
-        game.get_init_mutation_rounds(),
+        base_brain ? 0 : game.get_init_mutation_rounds(),
         game.get_init_add_node_thresh(),
         game.get_init_add_connection_thresh(),
         base_brain,
-        game.get_neat_innovations(),
-        game.get_neat_last_innovation_id(),
+        &game.get_innovation_registry(),
         &game);
     circle->set_creation_time(game.get_sim_time());
     circle->set_last_division_time(game.get_sim_time());
@@ -176,7 +169,12 @@ std::unique_ptr<CreatureCircle> Spawner::create_creature_at(const b2Vec2& pos) {
 
 std::unique_ptr<EatableCircle> Spawner::create_eatable_at(const b2Vec2& pos, bool toxic, bool division_pellet) const {
     float radius = radius_from_area(game.get_add_eatable_area());
-    auto circle = std::make_unique<EatableCircle>(game.worldId, pos.x, pos.y, radius, game.get_circle_density(), toxic, division_pellet, 0.0f);
+    auto circle = std::make_unique<EatableCircle>(game.worldId, pos.x, pos.y, radius, game.get_circle_density(), toxic, division_pellet, 0.0f,
+                                                  /*boost_particle=*/false, /*with_body=*/false);
+    circle->set_body_motion(game.get_pellet_body_motion());
+    if (!game.get_lightweight_pellets()) {
+        circle->ensure_body();
+    }
     circle->set_impulse_magnitudes(game.get_linear_impulse_magnitude(), game.get_angular_impulse_magnitude());
     circle->set_linear_damping(game.get_linear_damping(), game.worldId);
     circle->set_angular_damping(game.get_angular_damping(), game.worldId);
@@ -198,8 +196,8 @@ void Spawner::spawn_eatable_cloud(const CreatureCircle& creature, std::vector<st
         float piece_radius = radius_from_area(use_area);
         float max_offset = std::max(0.0f, creature_radius - piece_radius);
 
-        float angle = static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX) * 2.0f * PI;
-        float dist = max_offset * std::sqrt(random_unit());
+        float angle = game.random_unit() * 2.0f * PI;
+        float dist = max_offset * std::sqrt(game.random_unit());
         b2Vec2 pos = creature.getPosition();
         b2Vec2 piece_pos = {pos.x + std::cos(angle) * dist, pos.y + std::sin(angle) * dist};
 
@@ -247,7 +245,7 @@ void Spawner::sprinkle_with_rate(float rate, int type, float dt) {
         }
     }
 
-    float roll = static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX);
+    float roll = game.random_unit();
     if (roll < remainder) {
         (void)spawn_once();
     }
@@ -0,0 +1,107 @@
+#include "game/view_culler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "eatable_circle.hpp"
+
+namespace {
+constexpr float MIN_CELL_SIZE = 0.5f;
+constexpr float TARGET_ENTRIES_PER_CELL = 4.0f;
+constexpr std::size_t MAX_CELLS = 1u << 16;
+} // namespace
+
+void ViewCuller::rebuild(const std::vector<std::unique_ptr<EatableCircle>>& circles) {
+    scratch.clear();
+    max_radius = 0.0f;
+    float min_x = std::numeric_limits<float>::max();
+    float min_y = std::numeric_limits<float>::max();
+    float max_x = std::numeric_limits<float>::lowest();
+    float max_y = std::numeric_limits<float>::lowest();
+
+    for (std::size_t i = 0; i < circles.size(); ++i) {
+        const b2Vec2 pos = circles[i]->getPosition();
+        const float r = circles[i]->getRadius();
+        scratch.push_back(Entry{pos.x, pos.y, r, static_cast<std::uint32_t>(i)});
+        max_radius = std::max(max_radius, r);
+        min_x = std::min(min_x, pos.x);
+        min_y = std::min(min_y, pos.y);
+        max_x = std::max(max_x, pos.x);
+        max_y = std::max(max_y, pos.y);
+    }
+
+    entries.clear();
+    if (scratch.empty()) {
+        columns = 0;
+        rows = 0;
+        return;
+    }
+    origin_x = min_x;
+    origin_y = min_y;
+
+    // Size cells for a few circles each; the query widens by max_radius, so large
+    // creatures only cost one extra ring of cells.
+    const float extent_x = max_x - min_x;
+    const float extent_y = max_y - min_y;
+    const float area_per_entry = (extent_x + MIN_CELL_SIZE) * (extent_y + MIN_CELL_SIZE) / static_cast<float>(scratch.size());
+    float cell_size = std::max(std::sqrt(area_per_entry * TARGET_ENTRIES_PER_CELL), MIN_CELL_SIZE);
+    while ((std::floor(extent_x / cell_size) + 1.0f) * (std::floor(extent_y / cell_size) + 1.0f) > static_cast<float>(MAX_CELLS)) {
+        cell_size *= 2.0f;
+    }
+    inverse_cell_size = 1.0f / cell_size;
+    columns = static_cast<int>(extent_x * inverse_cell_size) + 1;
+    rows = static_cast<int>(extent_y * inverse_cell_size) + 1;
+
+    const std::size_t cell_count = static_cast<std::size_t>(columns) * static_cast<std::size_t>(rows);
+    cell_start.assign(cell_count + 1, 0);
+    entry_cells.resize(scratch.size());
+    for (std::size_t i = 0; i < scratch.size(); ++i) {
+        const int cx = std::min(cell_coord_x(scratch[i].x), columns - 1);
+        const int cy = std::min(cell_coord_y(scratch[i].y), rows - 1);
+        const auto cell = static_cast<std::uint32_t>(cy * columns + cx);
+        entry_cells[i] = cell;
+        ++cell_start[cell + 1];
+    }
+    for (std::size_t c = 0; c < cell_count; ++c) {
+        cell_start[c + 1] += cell_start[c];
+    }
+
+    entries.resize(scratch.size());
+    cell_fill.assign(cell_start.begin(), cell_start.end() - 1);
+    for (std::size_t i = 0; i < scratch.size(); ++i) {
+        entries[cell_fill[entry_cells[i]]++] = scratch[i];
+    }
+}
+
+void ViewCuller::query(const sf::FloatRect& rect, std::vector<std::uint32_t>& out) const {
+    out.clear();
+    if (entries.empty()) {
+        return;
+    }
+    const float left = rect.position.x;
+    const float top = rect.position.y;
+    const float right = left + rect.size.x;
+    const float bottom = top + rect.size.y;
+    if (right + max_radius < origin_x || bottom + max_radius < origin_y) {
+        return;
+    }
+
+    const int x0 = std::max(cell_coord_x(left - max_radius), 0);
+    const int x1 = std::min(cell_coord_x(right + max_radius), columns - 1);
+    const int y0 = std::max(cell_coord_y(top - max_radius), 0);
+    const int y1 = std::min(cell_coord_y(bottom + max_radius), rows - 1);
+    for (int cy = y0; cy <= y1; ++cy) {
+        for (int cx = x0; cx <= x1; ++cx) {
+            const std::size_t cell = static_cast<std::size_t>(cy) * static_cast<std::size_t>(columns) + static_cast<std::size_t>(cx);
+            for (std::uint32_t i = cell_start[cell]; i < cell_start[cell + 1]; ++i) {
+                const Entry& e = entries[i];
+                if (e.x + e.radius >= left && e.x - e.radius <= right &&
+                    e.y + e.radius >= top && e.y - e.radius <= bottom) {
+                    out.push_back(e.index);
+                }
+            }
+        }
+    }
+    std::sort(out.begin(), out.end());
+}
@@ -0,0 +1,72 @@
+#include "island_model.hpp"
+
+#include <algorithm>
+#include <limits>
+
+MigrationChannel::MigrationChannel(std::size_t dish_count) {
+    inboxes.reserve(dish_count);
+    for (std::size_t i = 0; i < dish_count; ++i) {
+        inboxes.push_back(std::make_unique<Inbox>());
+    }
+}
+
+void MigrationChannel::send(std::size_t to_dish, std::vector<Game::Migrant> migrants) {
+    Inbox& inbox = *inboxes[to_dish];
+    std::lock_guard<std::mutex> lock(inbox.mutex);
+    for (auto& migrant : migrants) {
+        inbox.migrants.push_back(std::move(migrant));
+    }
+}
+
+std::vector<Game::Migrant> MigrationChannel::receive(std::size_t dish) {
+    Inbox& inbox = *inboxes[dish];
+    std::lock_guard<std::mutex> lock(inbox.mutex);
+    std::vector<Game::Migrant> received;
+    received.swap(inbox.migrants);
+    return received;
+}
+
+IslandModel::IslandModel(DishPool& pool_ref)
+    : pool(pool_ref),
+      channel(pool_ref.size()) {
+    next_exchange_time = settings.interval;
+}
+
+float IslandModel::slowest_sim_time() const {
+    float slowest = std::numeric_limits<float>::max();
+    for (std::size_t i = 0; i < pool.size(); ++i) {
+        slowest = std::min(slowest, pool.dish(i).get_sim_time());
+    }
+    return slowest;
+}
+
+void IslandModel::update() {
+    const float now = slowest_sim_time();
+    if (!settings.enabled) {
+        next_exchange_time = now + settings.interval;
+        return;
+    }
+    if (now < next_exchange_time) {
+        return;
+    }
+    migrate_now();
+    next_exchange_time = now + std::max(settings.interval, 0.0f);
+}
+
+void IslandModel::migrate_now() {
+    const std::size_t dish_count = pool.size();
+    if (dish_count < 2 || settings.migrants_per_exchange <= 0) {
+        return;
+    }
+
+    // Two phases so every inbox is filled before any dish reads from it.
+    const auto count = static_cast<std::size_t>(settings.migrants_per_exchange);
+    const Game::MigrantRank rank = settings.rank;
+    pool.for_each_parallel_indexed([&](std::size_t index, Game& dish) {
+        channel.send((index + 1) % dish_count, dish.export_migrants(count, rank));
+    });
+    pool.for_each_parallel_indexed([&](std::size_t index, Game& dish) {
+        dish.import_migrants(channel.receive(index));
+    });
+    ++exchange_count;
+}
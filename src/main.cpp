@@ -1,5 +1,11 @@
 #include <iostream>
 
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
 #include <vector>
 
 #include <SFML/Graphics.hpp>
@@ -8,18 +14,304 @@
 
 #include <box2d/box2d.h>
 
+#include "dish_pool.hpp"
+#include "frame_capture.hpp"
 #include "game.hpp"
+#include "island_model.hpp"
+#include "physics_allocator.hpp"
+#include "sweep.hpp"
 #include "ui.hpp"
 
 #include <time.h>
 
-void handle_events(sf::RenderWindow& window, sf::View& view, Game& game);
+namespace {
+struct CommandLineOptions {
+    bool headless = false;
+    bool show_help = false;
+    std::size_t dishes = 1;
+    std::size_t threads = 0;
+    std::uint32_t seed = 0;
+    bool seed_given = false;
+    float sim_seconds = 600.0f;
+    float report_seconds = 10.0f;
+    float migrate_every = 0.0f;
+    int migrants = 2;
+    Game::MigrantRank migrate_by = Game::MigrantRank::Oldest;
+    std::string telemetry_path;
+    std::string trace_path;
+    float telemetry_interval = 1.0f;
+    float qos_speed = -1.0f;
+    std::size_t physics_arena_mib = physics_allocator::DEFAULT_ARENA_MIB;
+    FrameCapture::Settings capture;
+    std::vector<SweepAxis> sweep;
+};
 
+void print_usage(const char* program) {
+    std::cerr << "Usage: " << program << " [options]\n"
+              << "  --headless            run without a window and print a CSV summary\n"
+              << "  --dishes N            dishes per sweep point (default 1)\n"
+              << "  --threads N           worker threads (default: hardware concurrency)\n"
+              << "  --seed S              base seed for the per-dish random streams\n"
+              << "  --sim-seconds T       simulated seconds per dish in headless mode (default 600)\n"
+              << "  --report-seconds T    progress interval in headless mode (default 10)\n"
+              << "  --sweep name=v1,v2    sweep a setting; repeat for a cartesian product\n"
+              << "                        settings: " << sweep_setting_names() << "\n"
+              << "  --migrate-every T     island model: migrate every T simulated seconds (default off)\n"
+              << "  --migrants K          creatures each dish sends per migration (default 2)\n"
+              << "  --migrate-by RANK     pick migrants by 'age' or 'size' (default age)\n"
+              << "  --telemetry PATH      write population statistics to a columnar log (one file per dish)\n"
+              << "  --telemetry-interval T  simulated seconds between telemetry rows (default 1)\n"
+              << "  --trace PATH          record births, deaths, eats and divisions (one file per dish)\n"
+              << "  --capture PREFIX      save a frame of every dish to PREFIX_NNNNNN.png for time-lapses\n"
+              << "  --capture-interval T  simulated seconds between captured frames (default 10)\n"
+              << "  --capture-size WxH    captured frame size in pixels (default 1280x720)\n"
+              << "  --capture-format F    'png' or 'raw' (headerless RGBA, default png)\n"
+              << "  --qos SPEED           degrade brain rate, sprinkling and divisions to hold SPEED sim s per wall s\n"
+              << "                        (0 follows the time scale); adjustments are logged to stderr\n"
+              << "  --physics-arena MIB   address space reserved for Box2D memory (default " << physics_allocator::DEFAULT_ARENA_MIB << ", 0 uses the heap)\n";
+}
 
-int main() {
-    srand(time(NULL));
+bool parse_command_line(int argc, char** argv, CommandLineOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto next_value = [&](const char* name) -> const char* {
+            if (i + 1 >= argc) {
+                std::cerr << name << " needs a value\n";
+                return nullptr;
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--headless") {
+            options.headless = true;
+        } else if (arg == "--help" || arg == "-h") {
+            options.show_help = true;
+        } else if (arg == "--dishes" || arg == "--threads" || arg == "--seed" || arg == "--physics-arena") {
+            const char* value = next_value(arg.c_str());
+            if (!value) return false;
+            const unsigned long parsed = std::strtoul(value, nullptr, 10);
+            if (arg == "--dishes") {
+                options.dishes = std::max<std::size_t>(1, parsed);
+            } else if (arg == "--threads") {
+                options.threads = parsed;
+            } else if (arg == "--physics-arena") {
+                options.physics_arena_mib = parsed;
+            } else {
+                options.seed = static_cast<std::uint32_t>(parsed);
+                options.seed_given = true;
+            }
+        } else if (arg == "--sim-seconds" || arg == "--report-seconds" || arg == "--migrate-every" || arg == "--telemetry-interval" || arg == "--capture-interval" || arg == "--qos") {
+            const char* value = next_value(arg.c_str());
+            if (!value) return false;
+            const float parsed = std::max(0.0f, std::strtof(value, nullptr));
+            if (arg == "--sim-seconds") {
+                options.sim_seconds = parsed;
+            } else if (arg == "--report-seconds") {
+                options.report_seconds = parsed;
+            } else if (arg == "--telemetry-interval") {
+                options.telemetry_interval = parsed;
+            } else if (arg == "--capture-interval") {
+                options.capture.interval = parsed;
+            } else if (arg == "--qos") {
+                options.qos_speed = parsed;
+            } else {
+                options.migrate_every = parsed;
+            }
+        } else if (arg == "--migrants") {
+            const char* value = next_value("--migrants");
+            if (!value) return false;
+            options.migrants = std::max(0, std::atoi(value));
+        } else if (arg == "--migrate-by") {
+            const char* value = next_value("--migrate-by");
+            if (!value) return false;
+            const std::string rank = value;
+            if (rank == "age") {
+                options.migrate_by = Game::MigrantRank::Oldest;
+            } else if (rank == "size") {
+                options.migrate_by = Game::MigrantRank::Largest;
+            } else {
+                std::cerr << "--migrate-by expects 'age' or 'size'\n";
+                return false;
+            }
+        } else if (arg == "--telemetry" || arg == "--trace") {
+            const char* value = next_value(arg.c_str());
+            if (!value) return false;
+            (arg == "--telemetry" ? options.telemetry_path : options.trace_path) = value;
+        } else if (arg == "--capture") {
+            const char* value = next_value("--capture");
+            if (!value) return false;
+            options.capture.prefix = value;
+        } else if (arg == "--capture-size") {
+            const char* value = next_value("--capture-size");
+            if (!value) return false;
+            unsigned int width = 0;
+            unsigned int height = 0;
+            if (std::sscanf(value, "%ux%u", &width, &height) != 2 || width == 0 || height == 0) {
+                std::cerr << "--capture-size expects WxH, e.g. 1920x1080\n";
+                return false;
+            }
+            options.capture.size = {width, height};
+        } else if (arg == "--capture-format") {
+            const char* value = next_value("--capture-format");
+            if (!value) return false;
+            const std::string format = value;
+            if (format == "png") {
+                options.capture.format = FrameCapture::Format::Png;
+            } else if (format == "raw") {
+                options.capture.format = FrameCapture::Format::Raw;
+            } else {
+                std::cerr << "--capture-format expects 'png' or 'raw'\n";
+                return false;
+            }
+        } else if (arg == "--sweep") {
+            const char* value = next_value("--sweep");
+            if (!value) return false;
+            SweepAxis axis;
+            std::string error;
+            if (!parse_sweep_axis(value, axis, error)) {
+                std::cerr << "--sweep: " << error << "\n";
+                return false;
+            }
+            options.sweep.push_back(std::move(axis));
+        } else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+// Dish i runs sweep point i / dishes_per_point, so replicates sit next to each other.
+void configure_dishes(DishPool& pool, const std::vector<SweepPoint>& points, std::size_t dishes_per_point) {
+    for (std::size_t i = 0; i < pool.size(); ++i) {
+        apply_sweep_point(pool.dish(i), points[i / dishes_per_point]);
+    }
+}
+
+// "run.ptl" becomes "run.dish3.ptl" when several dishes share one output path.
+std::string path_for_dish(const std::string& path, std::size_t index, std::size_t dish_count) {
+    if (dish_count <= 1) {
+        return path;
+    }
+    const std::size_t slash = path.find_last_of("/\\");
+    const std::size_t dot = path.find_last_of('.');
+    const bool has_extension = dot != std::string::npos && (slash == std::string::npos || dot > slash);
+    const std::string tag = ".dish" + std::to_string(index);
+    return has_extension ? path.substr(0, dot) + tag + path.substr(dot) : path + tag;
+}
+
+bool start_recording(DishPool& pool, const CommandLineOptions& options) {
+    for (std::size_t i = 0; i < pool.size(); ++i) {
+        Game& dish = pool.dish(i);
+        if (!options.telemetry_path.empty()) {
+            const std::string path = path_for_dish(options.telemetry_path, i, pool.size());
+            if (!dish.start_telemetry(path, options.telemetry_interval)) {
+                std::cerr << "Cannot write telemetry to " << path << "\n";
+                return false;
+            }
+        }
+        if (!options.trace_path.empty()) {
+            const std::string path = path_for_dish(options.trace_path, i, pool.size());
+            if (!dish.start_event_trace(path)) {
+                std::cerr << "Cannot write event trace to " << path << "\n";
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void enable_qos(DishPool& pool, const CommandLineOptions& options) {
+    if (options.qos_speed < 0.0f) {
+        return;
+    }
+    for (std::size_t i = 0; i < pool.size(); ++i) {
+        QosGovernor& qos = pool.dish(i).get_qos_governor();
+        qos.get_settings().target_speed = options.qos_speed;
+        qos.set_enabled(true);
+    }
+}
+
+void print_qos_log(DishPool& pool) {
+    for (std::size_t i = 0; i < pool.size(); ++i) {
+        for (const std::string& line : pool.dish(i).get_qos_governor().take_pending_log()) {
+            std::cerr << "dish " << i << ": " << line << "\n";
+        }
+    }
+}
+
+void print_summary_header(const std::vector<SweepAxis>& axes) {
+    std::cout << "dish,seed";
+    for (const auto& axis : axes) {
+        std::cout << ',' << axis.name;
+    }
+    std::cout << ",sim_time,creatures,max_generation,food_pellets,toxic_pellets,division_pellets,longest_life\n";
+}
+
+void print_summary_row(std::size_t index, Game& game, const SweepPoint& point) {
+    std::cout << index << ',' << game.get_seed();
+    for (const auto& entry : point) {
+        std::cout << ',' << entry.second;
+    }
+    std::cout << ',' << game.get_sim_time()
+              << ',' << game.get_creature_count()
+              << ',' << game.get_max_generation()
+              << ',' << game.get_food_pellet_count()
+              << ',' << game.get_toxic_pellet_count()
+              << ',' << game.get_division_pellet_count()
+              << ',' << game.get_longest_life_since_creation()
+              << '\n';
+}
+
+void print_capture_summary(const FrameCapture& capture) {
+    std::cerr << "captured " << capture.get_written_count() << " frames";
+    if (capture.get_dropped_count() > 0 || capture.get_failed_count() > 0) {
+        std::cerr << " (" << capture.get_dropped_count() << " dropped while encoders were busy, "
+                  << capture.get_failed_count() << " failed to write)";
+    }
+    std::cerr << "\n";
+}
+
+int run_headless(DishPool& pool, IslandModel& islands, FrameCapture& capture, const CommandLineOptions& options, const std::vector<SweepPoint>& points) {
+    constexpr float timeStep = 1.0f / 60.0f;
+    constexpr int ticks_per_second = 60;
+    const int total_ticks = static_cast<int>(options.sim_seconds / timeStep);
+    const int report_ticks = std::max(1, static_cast<int>(options.report_seconds / timeStep));
+
+    // Step in one-second chunks so migrations land close to their scheduled time.
+    int next_report = report_ticks;
+    for (int done = 0; done < total_ticks;) {
+        const int chunk = std::min(ticks_per_second, total_ticks - done);
+        pool.for_each_parallel([chunk](Game& game) {
+            for (int t = 0; t < chunk; ++t) {
+                game.process_game_logic();
+            }
+        });
+        islands.update();
+        capture.update();
+        print_qos_log(pool);
+        done += chunk;
+        if (done >= next_report || done == total_ticks) {
+            std::cerr << "simulated " << static_cast<float>(done) * timeStep << " / " << options.sim_seconds << " s\n";
+            next_report += report_ticks;
+        }
+    }
+
+    if (capture.is_active()) {
+        capture.stop();
+        print_capture_summary(capture);
+    }
+    print_summary_header(options.sweep);
+    for (std::size_t i = 0; i < pool.size(); ++i) {
+        print_summary_row(i, pool.dish(i), points[i / options.dishes]);
+    }
+    return 0;
+}
+
+void handle_events(sf::RenderWindow& window, sf::View& view, Game& game);
 
-    Game game;
+int run_gui(DishPool& pool, IslandModel& islands, FrameCapture& capture) {
+    std::size_t active_dish = 0;
 
     sf::RenderWindow window(sf::VideoMode({1280, 720}), "Petri Dish Simulation");
     window.setFramerateLimit(60);
@@ -29,17 +321,22 @@ int main() {
     sf::Clock deltaClock;
     sf::View view = window.getDefaultView();
     float aspect = static_cast<float>(window.getSize().x) / static_cast<float>(window.getSize().y);
-    float world_height = game.get_petri_radius() * 2.0f;
+    float world_height = pool.dish(active_dish).get_petri_radius() * 2.0f;
     float world_width = world_height * aspect;
     view.setSize({world_width, world_height});
     view.setCenter({0.0f, 0.0f});
     window.setView(view);
     while (window.isOpen()) {
         float dt = deltaClock.restart().asSeconds();
-        game.accumulate_real_time(dt);
-
-        game.process_game_logic_with_speed();
+        pool.for_each_parallel([dt](Game& dish) {
+            dish.accumulate_real_time(dt);
+            dish.process_game_logic_with_speed();
+        });
+        islands.update();
+        capture.update();
+        print_qos_log(pool);
 
+        Game& game = pool.dish(active_dish);
         handle_events(window, view, game);
 
         view = window.getView(); // sync view after input handling
@@ -47,11 +344,12 @@ int main() {
         window.setView(view);
         ImGui::SFML::Update(window, sf::seconds(dt));
 
-        render_ui(window, view, game);
+        render_dish_picker(pool, islands, active_dish);
+        render_ui(window, view, pool.dish(active_dish));
 
         window.clear();
         window.setView(view);
-        game.draw(window);
+        pool.dish(active_dish).draw(window);
         ImGui::SFML::Render(window);
         window.display();
     }
@@ -60,7 +358,58 @@ int main() {
 
     return 0;
 }
+} // namespace
+
+int main(int argc, char** argv) {
+    srand(time(NULL));
+
+    CommandLineOptions options;
+    if (!parse_command_line(argc, argv, options) || options.show_help) {
+        print_usage(argv[0]);
+        return options.show_help ? 0 : 1;
+    }
+
+    const std::vector<SweepPoint> points = expand_sweep(options.sweep);
+    const std::size_t dish_count = points.size() * options.dishes;
+    if (dish_count > DishPool::MAX_DISHES) {
+        std::cerr << "Too many dishes (" << dish_count << "); at most " << DishPool::MAX_DISHES << " fit in one process.\n";
+        return 1;
+    }
+
+    // Every world allocates through this, so it has to be in place before the first dish.
+    physics_allocator::install(options.physics_arena_mib << 20);
+
+    const std::uint32_t seed = options.seed_given ? options.seed : std::random_device{}();
+    DishPool pool(dish_count, options.threads, seed);
+    configure_dishes(pool, points, options.dishes);
+
+    IslandModel islands(pool);
+    IslandModel::Settings& migration = islands.get_settings();
+    migration.enabled = options.migrate_every > 0.0f;
+    if (migration.enabled) {
+        migration.interval = options.migrate_every;
+    }
+    migration.migrants_per_exchange = options.migrants;
+    migration.rank = options.migrate_by;
+
+    if (!start_recording(pool, options)) {
+        return 1;
+    }
+    enable_qos(pool, options);
+
+    FrameCapture capture(pool);
+    if (!options.capture.prefix.empty()) {
+        std::string error;
+        if (!capture.start(options.capture, error)) {
+            std::cerr << "--capture: " << error << "\n";
+            return 1;
+        }
+    }
+
+    return options.headless ? run_headless(pool, islands, capture, options, points) : run_gui(pool, islands, capture);
+}
 
+namespace {
 void handle_events(sf::RenderWindow& window, sf::View& view, Game& game) {
     static sf::Vector2u previous_window_size = window.getSize();
     while (const auto event = window.pollEvent()) {
@@ -89,3 +438,4 @@ void handle_events(sf::RenderWindow& window, sf::View& view, Game& game) {
         game.process_input_events(window, event);
     }
 }
+} // namespace
@@ -0,0 +1,193 @@
+#include "physics_allocator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include <box2d/box2d.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#define PHYSICS_ARENA_MMAP 1
+#endif
+
+namespace physics_allocator {
+namespace {
+// Arena blocks carry no header: the arena is cut into chunks and a side table records
+// the size class of each chunk, so a power-of-two request fills its class exactly.
+// Blocks below a chunk share a chunk of their class; larger ones start on a chunk.
+constexpr std::size_t MIN_CLASS_SHIFT = 6;
+constexpr std::size_t CHUNK_SHIFT = 16;
+constexpr std::size_t CLASS_COUNT = 26;
+constexpr std::size_t HUGE_PAGE_BYTES = std::size_t{2} << 20;
+// Heap fallback blocks keep their size in front; 64 bytes keeps Box2D's 32-byte alignment.
+constexpr std::size_t HEAP_HEADER_BYTES = 64;
+
+struct FreeBlock {
+    FreeBlock* next;
+};
+
+struct Arena {
+    std::mutex mutex;
+    std::byte* base = nullptr;
+    std::size_t reserved = 0;
+    std::size_t used = 0;
+    std::vector<std::uint8_t> chunk_classes;
+    std::array<FreeBlock*, CLASS_COUNT> free_lists{};
+    bool huge_pages = false;
+
+    bool contains(const void* memory) const {
+        const auto* byte = static_cast<const std::byte*>(memory);
+        return base && byte >= base && byte < base + reserved;
+    }
+};
+
+Arena arena;
+bool installed = false;
+std::atomic<std::size_t> current_bytes{0};
+std::atomic<std::size_t> peak_bytes{0};
+std::atomic<std::size_t> heap_bytes{0};
+std::atomic<std::uint64_t> allocation_count{0};
+
+std::size_t class_bytes(std::size_t size_class) {
+    return std::size_t{1} << (size_class + MIN_CLASS_SHIFT);
+}
+
+std::size_t size_class_for(std::size_t bytes) {
+    std::size_t size_class = 0;
+    while (size_class < CLASS_COUNT && class_bytes(size_class) < bytes) {
+        ++size_class;
+    }
+    return size_class;
+}
+
+void reserve_arena(std::size_t bytes) {
+#ifdef PHYSICS_ARENA_MMAP
+    bytes = (bytes >> CHUNK_SHIFT) << CHUNK_SHIFT;
+    if (bytes == 0) {
+        return;
+    }
+    // Over-reserve so the arena can start on a huge page boundary.
+    const std::size_t mapped = bytes + HUGE_PAGE_BYTES;
+    void* region = mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (region == MAP_FAILED) {
+        return;
+    }
+    const auto address = reinterpret_cast<std::uintptr_t>(region);
+    const std::uintptr_t aligned = (address + HUGE_PAGE_BYTES - 1) & ~(static_cast<std::uintptr_t>(HUGE_PAGE_BYTES) - 1);
+    arena.base = reinterpret_cast<std::byte*>(aligned);
+    arena.reserved = bytes;
+    arena.chunk_classes.assign(bytes >> CHUNK_SHIFT, 0);
+#ifdef MADV_HUGEPAGE
+    arena.huge_pages = madvise(arena.base, bytes, MADV_HUGEPAGE) == 0;
+#endif
+#else
+    (void)bytes;
+#endif
+}
+
+void* take_from_arena(std::size_t size_class) {
+    std::lock_guard<std::mutex> lock(arena.mutex);
+    if (FreeBlock* block = arena.free_lists[size_class]) {
+        arena.free_lists[size_class] = block->next;
+        return block;
+    }
+    const std::size_t block_bytes = class_bytes(size_class);
+    const std::size_t carve_bytes = std::max(block_bytes, std::size_t{1} << CHUNK_SHIFT);
+    if (arena.reserved - arena.used < carve_bytes) {
+        return nullptr;
+    }
+    std::byte* carved = arena.base + arena.used;
+    arena.chunk_classes[arena.used >> CHUNK_SHIFT] = static_cast<std::uint8_t>(size_class);
+    arena.used += carve_bytes;
+    // A fresh chunk of small blocks: hand out the first, queue the rest.
+    for (std::size_t offset = carve_bytes - block_bytes; offset > 0; offset -= block_bytes) {
+        auto* spare = reinterpret_cast<FreeBlock*>(carved + offset);
+        spare->next = arena.free_lists[size_class];
+        arena.free_lists[size_class] = spare;
+    }
+    return carved;
+}
+
+void count_allocation(std::size_t bytes) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    const std::size_t now = current_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    std::size_t peak = peak_bytes.load(std::memory_order_relaxed);
+    while (now > peak && !peak_bytes.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {
+    }
+}
+
+void* allocate(unsigned int size, int alignment) {
+    assert(static_cast<std::size_t>(alignment) <= HEAP_HEADER_BYTES);
+    (void)alignment;
+    const std::size_t size_class = size_class_for(size);
+    if (arena.base && size_class < CLASS_COUNT) {
+        if (void* block = take_from_arena(size_class)) {
+            count_allocation(class_bytes(size_class));
+            return block;
+        }
+    }
+
+    void* block = ::operator new(HEAP_HEADER_BYTES + size, std::align_val_t{HEAP_HEADER_BYTES});
+    *static_cast<std::size_t*>(block) = size;
+    heap_bytes.fetch_add(size, std::memory_order_relaxed);
+    count_allocation(size);
+    return static_cast<std::byte*>(block) + HEAP_HEADER_BYTES;
+}
+
+void release(void* memory) {
+    if (!memory) {
+        return;
+    }
+    if (!arena.contains(memory)) {
+        void* block = static_cast<std::byte*>(memory) - HEAP_HEADER_BYTES;
+        const std::size_t size = *static_cast<std::size_t*>(block);
+        heap_bytes.fetch_sub(size, std::memory_order_relaxed);
+        current_bytes.fetch_sub(size, std::memory_order_relaxed);
+        ::operator delete(block, std::align_val_t{HEAP_HEADER_BYTES});
+        return;
+    }
+    std::lock_guard<std::mutex> lock(arena.mutex);
+    const std::size_t chunk = static_cast<std::size_t>(static_cast<std::byte*>(memory) - arena.base) >> CHUNK_SHIFT;
+    const std::size_t size_class = arena.chunk_classes[chunk];
+    current_bytes.fetch_sub(class_bytes(size_class), std::memory_order_relaxed);
+    auto* free_block = static_cast<FreeBlock*>(memory);
+    free_block->next = arena.free_lists[size_class];
+    arena.free_lists[size_class] = free_block;
+}
+} // namespace
+
+void install(std::size_t arena_bytes) {
+    if (installed) {
+        return;
+    }
+    if (arena_bytes > 0) {
+        reserve_arena(arena_bytes);
+    }
+    b2SetAllocator(allocate, release);
+    installed = true;
+}
+
+bool is_installed() {
+    return installed;
+}
+
+Stats get_stats() {
+    Stats stats;
+    stats.requested_bytes = static_cast<std::size_t>(b2GetByteCount());
+    stats.current_bytes = current_bytes.load(std::memory_order_relaxed);
+    stats.peak_bytes = peak_bytes.load(std::memory_order_relaxed);
+    stats.heap_bytes = heap_bytes.load(std::memory_order_relaxed);
+    stats.allocations = allocation_count.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(arena.mutex);
+    stats.arena_used_bytes = arena.used;
+    stats.arena_reserved_bytes = arena.reserved;
+    stats.huge_pages = arena.huge_pages;
+    return stats;
+}
+
+} // namespace physics_allocator
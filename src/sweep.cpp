@@ -0,0 +1,117 @@
+#include "sweep.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+
+#include "game.hpp"
+
+namespace {
+struct SweepSetting {
+    const char* name;
+    void (*apply)(Game&, float);
+};
+
+constexpr SweepSetting kSweepSettings[] = {
+    {"food_density", [](Game& g, float v) { g.set_food_pellet_density(v); }},
+    {"toxic_density", [](Game& g, float v) { g.set_toxic_pellet_density(v); }},
+    {"division_density", [](Game& g, float v) { g.set_division_pellet_density(v); }},
+    {"add_node", [](Game& g, float v) { g.set_add_node_thresh(v); }},
+    {"add_connection", [](Game& g, float v) { g.set_add_connection_thresh(v); }},
+    {"mutate_weight", [](Game& g, float v) { g.set_mutate_weight_thresh(v); }},
+    {"mutate_weight_factor", [](Game& g, float v) { g.set_mutate_weight_factor(v); }},
+    {"mutation_rounds", [](Game& g, float v) { g.set_mutation_rounds(static_cast<int>(v)); }},
+    {"min_creatures", [](Game& g, float v) { g.set_minimum_creature_count(static_cast<int>(v)); }},
+    {"brain_hz", [](Game& g, float v) { g.set_brain_updates_per_sim_second(v); }},
+    {"live_mutation", [](Game& g, float v) { g.set_live_mutation_enabled(v != 0.0f); }},
+    {"scheduled_live_mutation", [](Game& g, float v) { g.set_scheduled_live_mutation(v != 0.0f); }},
+    {"staggered_brains", [](Game& g, float v) { g.set_staggered_brain_updates(v != 0.0f); }},
+    {"skip_unchanged_brains", [](Game& g, float v) { g.set_skip_unchanged_brain_inputs(v != 0.0f); }},
+    {"lightweight_pellets", [](Game& g, float v) { g.set_lightweight_pellets(v != 0.0f); }},
+    // 0 = dynamic, 1 = sleeping, 2 = static.
+    {"pellet_body", [](Game& g, float v) {
+        const int motion = std::clamp(static_cast<int>(v), 0, static_cast<int>(CirclePhysics::BodyMotion::Static));
+        g.set_pellet_body_motion(static_cast<CirclePhysics::BodyMotion>(motion));
+    }},
+    {"petri_radius", [](Game& g, float v) { g.set_petri_radius(v); }},
+};
+
+const SweepSetting* find_setting(const std::string& name) {
+    for (const auto& setting : kSweepSettings) {
+        if (name == setting.name) {
+            return &setting;
+        }
+    }
+    return nullptr;
+}
+} // namespace
+
+bool parse_sweep_axis(const std::string& text, SweepAxis& out, std::string& error) {
+    const auto eq = text.find('=');
+    if (eq == std::string::npos || eq == 0) {
+        error = "expected name=v1,v2,... but got '" + text + "'";
+        return false;
+    }
+    out.name = text.substr(0, eq);
+    out.values.clear();
+    if (!find_setting(out.name)) {
+        error = "unknown sweep setting '" + out.name + "' (known: " + sweep_setting_names() + ")";
+        return false;
+    }
+
+    std::stringstream values(text.substr(eq + 1));
+    std::string item;
+    while (std::getline(values, item, ',')) {
+        char* end = nullptr;
+        const float value = std::strtof(item.c_str(), &end);
+        if (item.empty() || end != item.c_str() + item.size()) {
+            error = "bad value '" + item + "' for " + out.name;
+            return false;
+        }
+        out.values.push_back(value);
+    }
+    if (out.values.empty()) {
+        error = "no values given for " + out.name;
+        return false;
+    }
+    return true;
+}
+
+std::vector<SweepPoint> expand_sweep(const std::vector<SweepAxis>& axes) {
+    std::vector<SweepPoint> points(1);
+    for (const auto& axis : axes) {
+        std::vector<SweepPoint> expanded;
+        expanded.reserve(points.size() * axis.values.size());
+        for (const auto& point : points) {
+            for (float value : axis.values) {
+                SweepPoint next = point;
+                next.emplace_back(axis.name, value);
+                expanded.push_back(std::move(next));
+            }
+        }
+        points = std::move(expanded);
+    }
+    return points;
+}
+
+bool apply_sweep_point(Game& game, const SweepPoint& point) {
+    for (const auto& [name, value] : point) {
+        const SweepSetting* setting = find_setting(name);
+        if (!setting) {
+            return false;
+        }
+        setting->apply(game, value);
+    }
+    return true;
+}
+
+std::string sweep_setting_names() {
+    std::string names;
+    for (const auto& setting : kSweepSettings) {
+        if (!names.empty()) {
+            names += ", ";
+        }
+        names += setting.name;
+    }
+    return names;
+}
@@ -0,0 +1,241 @@
+#include "telemetry.hpp"
+
+#include <bit>
+#include <cstring>
+#include <iterator>
+
+namespace telemetry {
+namespace {
+constexpr char FILE_MAGIC[4] = {'P', 'D', 'T', 'L'};
+constexpr char CHUNK_MAGIC[4] = {'C', 'H', 'N', 'K'};
+
+std::uint32_t float_bits(float value) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+float bits_float(std::uint32_t bits) {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+struct ColumnSpec {
+    const char* name;
+    ColumnType type;
+    std::uint32_t (*read)(const Record&);
+};
+
+#define TELEMETRY_F32(field) {#field, ColumnType::F32, [](const Record& r) { return float_bits(r.field); }}
+#define TELEMETRY_U32(field) {#field, ColumnType::U32, [](const Record& r) { return r.field; }}
+#define TELEMETRY_GEN(i) {"generation_bucket_" #i, ColumnType::U32, [](const Record& r) { return r.generation_histogram[i]; }}
+
+const ColumnSpec COLUMN_SPECS[] = {
+    TELEMETRY_F32(sim_time),
+    TELEMETRY_F32(wall_seconds),
+    TELEMETRY_F32(sim_speed),
+    TELEMETRY_U32(creatures),
+    TELEMETRY_U32(food_pellets),
+    TELEMETRY_U32(toxic_pellets),
+    TELEMETRY_U32(division_pellets),
+    TELEMETRY_U32(boost_particles),
+    TELEMETRY_U32(births),
+    TELEMETRY_U32(arrivals),
+    TELEMETRY_U32(deaths),
+    TELEMETRY_U32(max_generation),
+    TELEMETRY_GEN(0),
+    TELEMETRY_GEN(1),
+    TELEMETRY_GEN(2),
+    TELEMETRY_GEN(3),
+    TELEMETRY_GEN(4),
+    TELEMETRY_GEN(5),
+    TELEMETRY_GEN(6),
+    TELEMETRY_GEN(7),
+    TELEMETRY_F32(area_min),
+    TELEMETRY_F32(area_p25),
+    TELEMETRY_F32(area_median),
+    TELEMETRY_F32(area_p75),
+    TELEMETRY_F32(area_max),
+    TELEMETRY_F32(area_mean),
+    TELEMETRY_F32(brain_nodes_mean),
+    TELEMETRY_U32(brain_nodes_max),
+    TELEMETRY_F32(brain_connections_mean),
+    TELEMETRY_U32(brain_connections_max),
+    TELEMETRY_U32(physics_kib),
+    TELEMETRY_U32(physics_peak_kib),
+};
+
+#undef TELEMETRY_F32
+#undef TELEMETRY_U32
+#undef TELEMETRY_GEN
+
+static_assert(GENERATION_BUCKETS == 8, "COLUMN_SPECS lists one column per generation bucket.");
+
+// The file is little-endian; on big-endian hosts every integer is swapped on the way
+// in and out. The swap is its own inverse.
+template <typename T>
+T little_endian(T value) {
+    if constexpr (std::endian::native == std::endian::big) {
+        T swapped = 0;
+        for (std::size_t i = 0; i < sizeof(T); ++i) {
+            swapped = static_cast<T>((swapped << 8) | ((value >> (8 * i)) & 0xFF));
+        }
+        return swapped;
+    }
+    return value;
+}
+
+template <typename T>
+void write_raw(std::ofstream& out, const T& value) {
+    const T stored = little_endian(value);
+    out.write(reinterpret_cast<const char*>(&stored), sizeof(T));
+}
+
+template <typename T>
+bool read_raw(std::ifstream& in, T& value) {
+    if (!in.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+        return false;
+    }
+    value = little_endian(value);
+    return true;
+}
+} // namespace
+
+std::size_t generation_bucket(int generation) {
+    std::size_t bucket = 0;
+    for (int g = generation; g > 0 && bucket + 1 < GENERATION_BUCKETS; g >>= 1) {
+        ++bucket;
+    }
+    return bucket;
+}
+
+Writer::~Writer() {
+    close();
+}
+
+bool Writer::open(const std::string& path) {
+    close();
+    // Appending to an existing log would need its header checked; start a fresh file instead.
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+    const auto column_count = static_cast<std::uint32_t>(std::size(COLUMN_SPECS));
+    out.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+    write_raw(out, FORMAT_VERSION);
+    write_raw(out, column_count);
+    for (const auto& spec : COLUMN_SPECS) {
+        const auto name_length = static_cast<std::uint16_t>(std::strlen(spec.name));
+        write_raw(out, static_cast<std::uint8_t>(spec.type));
+        write_raw(out, name_length);
+        out.write(spec.name, name_length);
+    }
+    columns.assign(column_count, {});
+    for (auto& column : columns) {
+        column.reserve(rows_per_chunk);
+    }
+    buffered_rows = 0;
+    out.flush();
+    return static_cast<bool>(out);
+}
+
+void Writer::append(const Record& record) {
+    if (!out.is_open()) {
+        return;
+    }
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+        columns[i].push_back(little_endian(COLUMN_SPECS[i].read(record)));
+    }
+    if (++buffered_rows >= rows_per_chunk) {
+        flush();
+    }
+}
+
+void Writer::flush() {
+    if (!out.is_open() || buffered_rows == 0) {
+        return;
+    }
+    out.write(CHUNK_MAGIC, sizeof(CHUNK_MAGIC));
+    write_raw(out, static_cast<std::uint32_t>(buffered_rows));
+    for (auto& column : columns) {
+        out.write(reinterpret_cast<const char*>(column.data()), static_cast<std::streamsize>(column.size() * sizeof(std::uint32_t)));
+        column.clear();
+    }
+    buffered_rows = 0;
+    out.flush();
+}
+
+void Writer::close() {
+    if (out.is_open()) {
+        flush();
+        out.close();
+    }
+}
+
+bool Reader::open(const std::string& path, std::string& error) {
+    in.open(path, std::ios::binary);
+    if (!in) {
+        error = "cannot open " + path;
+        return false;
+    }
+    char magic[4];
+    std::uint32_t version = 0;
+    std::uint32_t column_count = 0;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, FILE_MAGIC, sizeof(magic)) != 0) {
+        error = path + " is not a telemetry log";
+        return false;
+    }
+    if (!read_raw(in, version) || version != FORMAT_VERSION) {
+        error = "unsupported telemetry version " + std::to_string(version);
+        return false;
+    }
+    if (!read_raw(in, column_count)) {
+        error = "truncated header";
+        return false;
+    }
+    columns.clear();
+    for (std::uint32_t i = 0; i < column_count; ++i) {
+        std::uint8_t type = 0;
+        std::uint16_t name_length = 0;
+        if (!read_raw(in, type) || !read_raw(in, name_length)) {
+            error = "truncated header";
+            return false;
+        }
+        Column column;
+        column.type = static_cast<ColumnType>(type);
+        column.name.resize(name_length);
+        if (!in.read(column.name.data(), name_length)) {
+            error = "truncated header";
+            return false;
+        }
+        columns.push_back(std::move(column));
+    }
+    return true;
+}
+
+bool Reader::next_chunk(std::vector<std::vector<double>>& values) {
+    char magic[4];
+    std::uint32_t rows = 0;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, CHUNK_MAGIC, sizeof(magic)) != 0 || !read_raw(in, rows)) {
+        return false;
+    }
+    values.assign(columns.size(), {});
+    std::vector<std::uint32_t> raw(rows);
+    for (std::size_t c = 0; c < columns.size(); ++c) {
+        if (!in.read(reinterpret_cast<char*>(raw.data()), static_cast<std::streamsize>(rows * sizeof(std::uint32_t)))) {
+            // Torn tail chunk from an interrupted run.
+            values.clear();
+            return false;
+        }
+        auto& column = values[c];
+        column.reserve(rows);
+        for (std::uint32_t stored : raw) {
+            const std::uint32_t bits = little_endian(stored);
+            column.push_back(columns[c].type == ColumnType::F32 ? static_cast<double>(bits_float(bits)) : static_cast<double>(bits));
+        }
+    }
+    return true;
+}
+
+} // namespace telemetry
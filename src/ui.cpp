@@ -3,8 +3,11 @@
 
 #include "ui.hpp"
 #include "creature_circle.hpp"
+#include "physics_allocator.hpp"
 #include <unordered_map>
 #include <algorithm>
+#include <span>
+#include <string>
 
 namespace {
 struct CursorSettings {
@@ -23,6 +26,8 @@ struct RegionSettings {
 
 struct BrainSettings {
     float updates_per_sim_second = 0.0f;
+    bool staggered = false;
+    bool skip_unchanged_inputs = false;
 };
 
 struct CreatureSettings {
@@ -57,6 +62,7 @@ struct MutationSettings {
     float tick_add_connection_thresh = 0.0f;
     float weight_extremum_init = 0.0f;
     bool live_mutation_enabled = false;
+    bool scheduled_live_mutation = false;
     bool allow_recurrent = false;
     float weight_thresh = 0.0f;
     float weight_full_change_thresh = 0.0f;
@@ -91,6 +97,14 @@ struct CleanupSettings {
     float cleanup_interval = 30.0f; // deprecated, kept for state init
 };
 
+struct PerformanceSettings {
+    bool lightweight_pellets = false;
+    bool view_culling = true;
+    bool level_of_detail = true;
+    int pellet_body_motion = 0;
+    float innovation_compaction_interval = 0.0f;
+};
+
 struct SelectionOption {
     const char* label;
     Game::SelectionMode mode;
@@ -101,20 +115,12 @@ constexpr int array_size(const T (&)[N]) {
     return static_cast<int>(N);
 }
 
-#ifndef NDEBUG
 constexpr SelectionOption kSelectionOptions[] = {
     {"Manual selection", Game::SelectionMode::Manual},
     {"Oldest (largest)", Game::SelectionMode::OldestLargest},
     {"Oldest (median)", Game::SelectionMode::OldestMedian},
     {"Oldest (smallest)", Game::SelectionMode::OldestSmallest}
 };
-#else
-constexpr SelectionOption kSelectionOptions[] = {
-    {"Manual selection", Game::SelectionMode::Manual},
-    {"Oldest (largest)", Game::SelectionMode::OldestLargest},
-    {"Oldest (smallest)", Game::SelectionMode::OldestSmallest}
-};
-#endif
 
 constexpr int kSelectionOptionCount = array_size(kSelectionOptions);
 
@@ -134,6 +140,20 @@ Game::SelectionMode selection_index_to_mode(int index) {
     return kSelectionOptions[index].mode;
 }
 
+// Node positions and the static connection/node layer of the selected brain. Both are
+// rebuilt only when the creature, its genome version, or the widget size changes;
+// per-frame work is just the activation overlay.
+struct BrainGraphCache {
+    const neat::Genome* genome = nullptr;
+    std::uint64_t entity_id = 0;
+    std::uint32_t genome_version = 0;
+    sf::Vector2u size{0, 0};
+    bool valid = false;
+    std::vector<sf::Vector2f> node_positions;
+    sf::RenderTexture texture;
+    std::size_t rebuild_count = 0;
+};
+
 struct UiState {
     CursorSettings cursor;
     TimeScaleSettings time_scale;
@@ -145,6 +165,8 @@ struct UiState {
     MutationSettings mutation;
     SpawningSettings spawning;
     CleanupSettings cleanup;
+    PerformanceSettings performance;
+    BrainGraphCache brain_graph;
     bool show_true_color = false;
     bool follow_selected = false;
     int selection_mode = 0;
@@ -195,95 +217,169 @@ void apply_preset(Preset preset, UiState& state, Game& game) {
     }
 }
 
-void render_brain_graph(const neat::Genome& brain) {
-    if (ImGui::BeginChild("BrainGraphGeneric", ImVec2(0, 220), true)) {
-        // Layout nodes by layer: inputs (layer 0), hidden (1..max), outputs (max+1).
-        const int outputStart = std::min<int>(brain.nbInput + 1, brain.nodes.size());
-        const int outputEnd = std::min<int>(outputStart + brain.nbOutput, brain.nodes.size());
-
-        // Build display layers that force outputs to the rightmost layer even if their raw
-        // layer values shrink during NEAT mutations.
-        std::vector<int> renderLayers(brain.nodes.size(), 0);
-        int maxHiddenLayer = 0;
-        for (size_t i = 0; i < brain.nodes.size(); ++i) {
-            const bool isOutput = static_cast<int>(i) >= outputStart && static_cast<int>(i) < outputEnd;
-            if (!isOutput) {
-                int l = std::max(0, brain.nodes[i].layer);
-                renderLayers[i] = l;
-                maxHiddenLayer = std::max(maxHiddenLayer, l);
-            }
+std::vector<sf::Vector2f> compute_brain_layout(const neat::Genome& brain, sf::Vector2f size) {
+    // Layout nodes by layer: inputs (layer 0), hidden (1..max), outputs (max+1).
+    const int outputStart = std::min<int>(brain.nbInput + 1, brain.nodes.size());
+    const int outputEnd = std::min<int>(outputStart + brain.nbOutput, brain.nodes.size());
+
+    // Build display layers that force outputs to the rightmost layer even if their raw
+    // layer values shrink during NEAT mutations.
+    std::vector<int> renderLayers(brain.nodes.size(), 0);
+    int maxHiddenLayer = 0;
+    for (size_t i = 0; i < brain.nodes.size(); ++i) {
+        const bool isOutput = static_cast<int>(i) >= outputStart && static_cast<int>(i) < outputEnd;
+        if (!isOutput) {
+            int l = std::max(0, brain.nodes[i].layer);
+            renderLayers[i] = l;
+            maxHiddenLayer = std::max(maxHiddenLayer, l);
         }
-        const int outputLayer = maxHiddenLayer + 1;
-        for (size_t i = 0; i < brain.nodes.size(); ++i) {
-            const bool isOutput = static_cast<int>(i) >= outputStart && static_cast<int>(i) < outputEnd;
-            renderLayers[i] = isOutput ? outputLayer : std::max(0, brain.nodes[i].layer);
+    }
+    const int outputLayer = maxHiddenLayer + 1;
+    for (size_t i = 0; i < brain.nodes.size(); ++i) {
+        const bool isOutput = static_cast<int>(i) >= outputStart && static_cast<int>(i) < outputEnd;
+        renderLayers[i] = isOutput ? outputLayer : std::max(0, brain.nodes[i].layer);
+    }
+
+    // Compact sparse layers so wide gaps in layer numbers don't waste space visually.
+    std::vector<int> uniqueLayers = renderLayers;
+    std::sort(uniqueLayers.begin(), uniqueLayers.end());
+    uniqueLayers.erase(std::unique(uniqueLayers.begin(), uniqueLayers.end()), uniqueLayers.end());
+    std::unordered_map<int, int> layerRemap;
+    layerRemap.reserve(uniqueLayers.size());
+    for (int i = 0; i < static_cast<int>(uniqueLayers.size()); ++i) {
+        layerRemap[uniqueLayers[i]] = i;
+    }
+    float pad = 10.0f;
+    sf::Vector2f min{pad, pad};
+    sf::Vector2f max{std::max(size.x - pad, 10.0f), std::max(size.y - pad, 10.0f)};
+
+    // Bucket nodes by layer
+    std::vector<std::vector<int>> layerBuckets(uniqueLayers.size());
+    for (size_t i = 0; i < brain.nodes.size(); ++i) {
+        int remappedLayer = layerRemap[renderLayers[i]];
+        layerBuckets[remappedLayer].push_back(static_cast<int>(i));
+    }
+
+    // Position nodes
+    std::vector<sf::Vector2f> positions(brain.nodes.size());
+    for (int layer = 0; layer < (int)layerBuckets.size(); ++layer) {
+        float x = (layerBuckets.size() > 1)
+                      ? min.x + (max.x - min.x) * (float(layer) / float(layerBuckets.size() - 1))
+                      : (min.x + max.x) * 0.5f;
+        int count = (int)layerBuckets[layer].size();
+        for (int idx = 0; idx < count; ++idx) {
+            float y = (count > 1)
+                          ? min.y + (max.y - min.y) * (float(idx) / float(count - 1))
+                          : (min.y + max.y) * 0.5f;
+            positions[layerBuckets[layer][idx]] = sf::Vector2f{x, y};
         }
+    }
+    return positions;
+}
+
+sf::Color to_sf_color(float r, float g, float b, float a) {
+    return sf::Color{
+        static_cast<std::uint8_t>(r * 255.0f),
+        static_cast<std::uint8_t>(g * 255.0f),
+        static_cast<std::uint8_t>(b * 255.0f),
+        static_cast<std::uint8_t>(a * 255.0f)};
+}
 
-        // Compact sparse layers so wide gaps in layer numbers don't waste space visually.
-        std::vector<int> uniqueLayers = renderLayers;
-        std::sort(uniqueLayers.begin(), uniqueLayers.end());
-        uniqueLayers.erase(std::unique(uniqueLayers.begin(), uniqueLayers.end()), uniqueLayers.end());
-        std::unordered_map<int, int> layerRemap;
-        layerRemap.reserve(uniqueLayers.size());
-        for (int i = 0; i < static_cast<int>(uniqueLayers.size()); ++i) {
-            layerRemap[uniqueLayers[i]] = i;
+void rebuild_brain_graph(const neat::Genome& brain, BrainGraphCache& cache) {
+    const sf::Vector2f size{static_cast<float>(cache.size.x), static_cast<float>(cache.size.y)};
+    cache.node_positions = compute_brain_layout(brain, size);
+    ++cache.rebuild_count;
+
+    if (!(cache.texture.getSize() == cache.size) && !cache.texture.resize(cache.size)) {
+        cache.valid = false;
+        return;
+    }
+    cache.texture.setSmooth(true);
+    cache.texture.clear(sf::Color::Transparent);
+
+    // Draw connections first, as one batch of quads so line width follows the weight.
+    sf::VertexArray lines(sf::PrimitiveType::Triangles);
+    const auto node_count = static_cast<int>(cache.node_positions.size());
+    for (const auto& c : brain.connections) {
+        if (!c.enabled) continue;
+        if (c.inNodeId < 0 || c.inNodeId >= node_count || c.outNodeId < 0 || c.outNodeId >= node_count) continue;
+        const sf::Vector2f p1 = cache.node_positions[c.inNodeId];
+        const sf::Vector2f p2 = cache.node_positions[c.outNodeId];
+        const sf::Vector2f d = p2 - p1;
+        const float length = std::sqrt(d.x * d.x + d.y * d.y);
+        if (length <= 0.0f) continue;
+        float w = std::clamp(std::fabs(c.weight), 0.0f, 5.0f);
+        float alpha = std::clamp(std::fabs(c.weight), 0.1f, 1.0f);
+        const sf::Color col = to_sf_color(c.weight >= 0 ? 0.2f : 0.8f, c.weight >= 0 ? 0.8f : 0.2f, 0.2f, alpha);
+        const float half_width = (1.0f + w * 0.3f) * 0.5f;
+        const sf::Vector2f n{-d.y / length * half_width, d.x / length * half_width};
+        const sf::Vertex quad[6] = {
+            {p1 + n, col, {}}, {p1 - n, col, {}}, {p2 + n, col, {}},
+            {p2 + n, col, {}}, {p1 - n, col, {}}, {p2 - n, col, {}}};
+        for (const sf::Vertex& v : quad) {
+            lines.append(v);
         }
+    }
+    cache.texture.draw(lines);
+
+    // Draw nodes
+    sf::CircleShape node(6.0f, 16);
+    node.setOrigin({6.0f, 6.0f});
+    node.setFillColor(to_sf_color(0.8f, 0.8f, 0.2f, 1.0f));
+    for (const sf::Vector2f& pos : cache.node_positions) {
+        node.setPosition(pos);
+        cache.texture.draw(node);
+    }
+    cache.texture.display();
+    cache.valid = true;
+}
+
+void render_brain_graph(const CreatureCircle* creature, const neat::Genome& brain, BrainGraphCache& cache) {
+    if (ImGui::BeginChild("BrainGraphGeneric", ImVec2(0, 220), true)) {
         ImVec2 avail = ImGui::GetContentRegionAvail();
-        ImVec2 origin = ImGui::GetCursorScreenPos();
-        float pad = 10.0f;
-        ImVec2 min = {origin.x + pad, origin.y + pad};
-        ImVec2 max = {origin.x + std::max(avail.x - pad, 10.0f), origin.y + std::max(avail.y - pad, 10.0f)};
-
-        struct DrawNode { ImVec2 pos; int id; int layer; };
-        std::vector<DrawNode> drawNodes;
-        drawNodes.reserve(brain.nodes.size());
-
-        // Bucket nodes by layer
-        std::vector<std::vector<int>> layerBuckets(uniqueLayers.size());
-        for (size_t i = 0; i < brain.nodes.size(); ++i) {
-            int remappedLayer = layerRemap[renderLayers[i]];
-            layerBuckets[remappedLayer].push_back(static_cast<int>(i));
-        }
-
-        // Position nodes
-        for (int layer = 0; layer < (int)layerBuckets.size(); ++layer) {
-            float x = (layerBuckets.size() > 1)
-                          ? min.x + (max.x - min.x) * (float(layer) / float(layerBuckets.size() - 1))
-                          : (min.x + max.x) * 0.5f;
-            int count = (int)layerBuckets[layer].size();
-            for (int idx = 0; idx < count; ++idx) {
-                float y = (count > 1)
-                              ? min.y + (max.y - min.y) * (float(idx) / float(count - 1))
-                              : (min.y + max.y) * 0.5f;
-                drawNodes.push_back({ImVec2{x, y}, layerBuckets[layer][idx], layer});
-            }
+        const sf::Vector2u size{
+            static_cast<unsigned int>(std::max(avail.x, 1.0f)),
+            static_cast<unsigned int>(std::max(avail.y, 1.0f))};
+        const std::uint64_t entity_id = creature ? creature->get_entity_id() : 0;
+        const std::uint32_t genome_version = creature ? creature->get_genome_version() : 0;
+        if (!cache.valid || cache.genome != &brain || cache.entity_id != entity_id ||
+            cache.genome_version != genome_version || !(cache.size == size)) {
+            cache.genome = &brain;
+            cache.entity_id = entity_id;
+            cache.genome_version = genome_version;
+            cache.size = size;
+            rebuild_brain_graph(brain, cache);
         }
 
-        std::unordered_map<int, ImVec2> posById;
-        posById.reserve(drawNodes.size());
-        for (const auto& dn : drawNodes) {
-            posById.emplace(dn.id, dn.pos);
+        ImVec2 origin = ImGui::GetCursorScreenPos();
+        if (cache.valid) {
+            ImGui::Image(cache.texture, sf::Vector2f{static_cast<float>(size.x), static_cast<float>(size.y)});
         }
 
+        // Activation overlay: the only part that changes between genome edits. Inputs and
+        // outputs come from the creature itself; a shared genome's node state belongs to
+        // whichever clone ran last, so hidden nodes are only shown for an unshared one.
         ImDrawList* dl = ImGui::GetWindowDrawList();
-        // Draw connections first
-        for (const auto& c : brain.connections) {
-            if (!c.enabled) continue;
-            auto it_in = posById.find(c.inNodeId);
-            auto it_out = posById.find(c.outNodeId);
-            if (it_in == posById.end() || it_out == posById.end()) continue;
-            ImVec2 p1 = it_in->second;
-            ImVec2 p2 = it_out->second;
-            float w = std::clamp(std::fabs(c.weight), 0.0f, 5.0f);
-            float alpha = std::clamp(std::fabs(c.weight), 0.1f, 1.0f);
-            ImU32 col = ImGui::GetColorU32(ImVec4(c.weight >= 0 ? 0.2f : 0.8f, c.weight >= 0 ? 0.8f : 0.2f, 0.2f, alpha));
-            dl->AddLine(p1, p2, col, 1.0f + w * 0.3f);
-        }
-
-        // Draw nodes
-        for (auto& dn : drawNodes) {
-            ImU32 col = ImGui::GetColorU32(ImVec4(0.8f, 0.8f, 0.2f, 1.0f));
-            dl->AddCircleFilled(dn.pos, 6.0f, col);
+        const std::size_t node_count = std::min(cache.node_positions.size(), brain.nodes.size());
+        const std::size_t output_start = static_cast<std::size_t>(brain.nbInput) + 1;
+        for (std::size_t i = 0; i < node_count; ++i) {
+            float value = brain.nodes[i].sumOutput;
+            if (creature) {
+                const std::span<const float> inputs = creature->get_brain_inputs();
+                const std::span<const float> outputs = creature->get_brain_outputs();
+                if (i < inputs.size() && i < static_cast<std::size_t>(brain.nbInput)) {
+                    value = inputs[i];
+                } else if (i >= output_start && i - output_start < outputs.size() &&
+                           i - output_start < static_cast<std::size_t>(brain.nbOutput)) {
+                    value = outputs[i - output_start];
+                } else if (i >= output_start + static_cast<std::size_t>(brain.nbOutput) && creature->is_brain_shared()) {
+                    continue;
+                }
+            }
+            const float activation = std::clamp(std::fabs(value), 0.0f, 1.0f);
+            const sf::Vector2f pos = cache.node_positions[i];
+            ImU32 col = ImGui::GetColorU32(ImVec4(1.0f, 1.0f, 1.0f, activation));
+            dl->AddCircleFilled(ImVec2{origin.x + pos.x, origin.y + pos.y}, 4.0f, col);
         }
     }
     ImGui::EndChild();
@@ -343,6 +439,8 @@ void initialize_state(UiState& state, Game& game) {
     state.time_scale.requested = game.get_time_scale();
     state.time_scale.display = state.time_scale.requested;
     state.brain.updates_per_sim_second = game.get_brain_updates_per_sim_second();
+    state.brain.staggered = game.get_staggered_brain_updates();
+    state.brain.skip_unchanged_inputs = game.get_skip_unchanged_brain_inputs();
     state.creature.minimum_area = game.get_minimum_area();
     state.creature.average_area = game.get_average_creature_area();
     state.creature.boost_area = game.get_boost_area();
@@ -356,6 +454,7 @@ void initialize_state(UiState& state, Game& game) {
     state.mutation.tick_add_connection_thresh = game.get_tick_add_connection_thresh();
     state.mutation.weight_extremum_init = game.get_weight_extremum_init();
     state.mutation.live_mutation_enabled = game.get_live_mutation_enabled();
+    state.mutation.scheduled_live_mutation = game.get_scheduled_live_mutation();
     state.mutation.init_add_node_thresh = game.get_init_add_node_thresh();
     state.mutation.init_add_connection_thresh = game.get_init_add_connection_thresh();
     state.mutation.init_mutation_rounds = game.get_init_mutation_rounds();
@@ -390,6 +489,11 @@ void initialize_state(UiState& state, Game& game) {
     state.spawning.food_density = game.get_food_pellet_density();
     state.spawning.toxic_density = game.get_toxic_pellet_density();
     state.spawning.division_density = game.get_division_pellet_density();
+    state.performance.lightweight_pellets = game.get_lightweight_pellets();
+    state.performance.view_culling = game.get_view_culling();
+    state.performance.level_of_detail = game.get_level_of_detail();
+    state.performance.pellet_body_motion = static_cast<int>(game.get_pellet_body_motion());
+    state.performance.innovation_compaction_interval = game.get_innovation_compaction_interval();
     state.follow_selected = game.get_follow_selected();
     state.selection_mode = selection_mode_to_index(game.get_selection_mode());
     state.initialized = true;
@@ -496,6 +600,11 @@ void render_overview_content(Game& game, UiState& state) {
         show_hover_text("Longest survival among creatures since spawn and since their last division.");
         ImGui::Text("Max generation: %d", game.get_max_generation());
         show_hover_text("Highest division count reached by any creature so far.");
+        const InnovationRegistry& innovations = game.get_innovation_registry();
+        ImGui::Text("Innovation index: %zu pairs  %.1f KiB",
+                    innovations.size(),
+                    static_cast<float>(innovations.memory_bytes()) / 1024.0f);
+        show_hover_text("Node pairs with an innovation id, and the memory their lookup table holds.");
     }
 
     if (ImGui::CollapsingHeader("Follow targets & selection", ImGuiTreeNodeFlags_DefaultOpen)) {
@@ -534,7 +643,7 @@ void render_overview_content(Game& game, UiState& state) {
                 ImGui::Text("Area: %.3f  Radius: %.3f", creature->getArea(), creature->getRadius());
             }
 
-            render_brain_graph(*selected_brain);
+            render_brain_graph(game.get_selected_creature(), *selected_brain, state.brain_graph);
         } else {
             ImGui::Separator();
             ImGui::Text("No creature selected");
@@ -560,6 +669,18 @@ void render_simulation_tab(Game& game, UiState& state) {
             game.set_brain_updates_per_sim_second(state.brain.updates_per_sim_second);
         }
         show_hover_text("How many times creature AI brains tick per simulated second.");
+        if (ImGui::Checkbox("Stagger brain updates", &state.brain.staggered)) {
+            game.set_staggered_brain_updates(state.brain.staggered);
+        }
+        show_hover_text("Give each creature its own phase so a slice of the population thinks every physics tick instead of all at once.");
+        if (ImGui::Checkbox("Skip brains with unchanged inputs", &state.brain.skip_unchanged_inputs)) {
+            game.set_skip_unchanged_brain_inputs(state.brain.skip_unchanged_inputs);
+        }
+        show_hover_text("Reuse the last outputs when a feedforward brain would see exactly the same inputs, memory included.");
+        const std::size_t brain_runs = game.get_brain_evaluation_count() + game.get_brain_reuse_count();
+        if (brain_runs > 0) {
+            ImGui::Text("Brain evaluations skipped: %.1f%%", 100.0 * static_cast<double>(game.get_brain_reuse_count()) / static_cast<double>(brain_runs));
+        }
     }
 
     if (ImGui::CollapsingHeader("Sizes & costs", ImGuiTreeNodeFlags_DefaultOpen)) {
@@ -709,6 +830,10 @@ void render_mutation_tab(Game& game, UiState& state) {
             game.set_tick_add_node_thresh(state.mutation.tick_add_node_thresh);
             game.set_tick_add_connection_thresh(state.mutation.tick_add_connection_thresh);
         }
+        if (ImGui::Checkbox("Scheduled live mutation", &state.mutation.scheduled_live_mutation)) {
+            game.set_scheduled_live_mutation(state.mutation.scheduled_live_mutation);
+        }
+        show_hover_text("Sample when each creature next mutates instead of calling NEAT mutate on every brain every tick. Same average rates, far less work at large populations.");
         ImGui::EndDisabled();
 
         ImGui::SeparatorText("Initialization mutation (matches NEAT mutate)");
@@ -728,6 +853,142 @@ void render_mutation_tab(Game& game, UiState& state) {
 
     ImGui::EndTabItem();
 }
+
+void render_performance_tab(Game& game, UiState& state) {
+    if (!ImGui::BeginTabItem("Performance")) {
+        return;
+    }
+
+    if (ImGui::CollapsingHeader("Pellets", ImGuiTreeNodeFlags_DefaultOpen)) {
+        if (ImGui::Checkbox("Lightweight pellets (no physics bodies)", &state.performance.lightweight_pellets)) {
+            game.set_lightweight_pellets(state.performance.lightweight_pellets);
+        }
+        show_hover_text("Pellets skip Box2D and are found by creatures through a grid; a pellet gets a body only when pushed.");
+        ImGui::Text("Bodyless pellets: %zu", game.get_lightweight_pellet_count());
+
+        ImGui::BeginDisabled(state.performance.lightweight_pellets);
+        constexpr const char* kBodyMotionLabels[] = {"Dynamic", "Sleeping", "Static"};
+        if (ImGui::Combo("Pellet body type", &state.performance.pellet_body_motion, kBodyMotionLabels, array_size(kBodyMotionLabels))) {
+            game.set_pellet_body_motion(static_cast<CirclePhysics::BodyMotion>(state.performance.pellet_body_motion));
+        }
+        show_hover_text("How pellets with physics bodies rest: Sleeping lets Box2D park them quickly, Static keeps them out of the solver entirely. Pushed pellets turn dynamic until they stop.");
+        ImGui::EndDisabled();
+    }
+
+    if (ImGui::CollapsingHeader("Rendering", ImGuiTreeNodeFlags_DefaultOpen)) {
+        if (ImGui::Checkbox("View culling", &state.performance.view_culling)) {
+            game.set_view_culling(state.performance.view_culling);
+        }
+        show_hover_text("Only circles inside the visible area are drawn, found through a grid rebuilt each frame.");
+        ImGui::Text("Drawn circles: %zu / %zu", game.get_drawn_circle_count(), game.get_drawable_circle_count());
+        if (ImGui::Checkbox("Level of detail", &state.performance.level_of_detail)) {
+            game.set_level_of_detail(state.performance.level_of_detail);
+        }
+        show_hover_text("Small circles are batched into one low-poly mesh and sub-pixel pellets are blended into a density texture.");
+        if (state.performance.level_of_detail) {
+            const LodRenderer::Stats& lod = game.get_lod_stats();
+            ImGui::Text("Full: %zu  low detail: %zu  density: %zu", lod.full, lod.low_detail, lod.density);
+        }
+        ImGui::Text("Brain graph redraws: %zu", state.brain_graph.rebuild_count);
+        show_hover_text("The selected brain is laid out into a texture only when its genome changes.");
+    }
+
+    if (ImGui::CollapsingHeader("Physics memory")) {
+        const physics_allocator::Stats memory = physics_allocator::get_stats();
+        constexpr double kMiB = 1024.0 * 1024.0;
+        if (!physics_allocator::is_installed()) {
+            ImGui::TextUnformatted("Box2D uses its default allocator.");
+        }
+        ImGui::Text("Box2D blocks: %.1f MiB (peak %.1f MiB)", static_cast<double>(memory.current_bytes) / kMiB, static_cast<double>(memory.peak_bytes) / kMiB);
+        ImGui::Text("Requested by Box2D: %.1f MiB", static_cast<double>(memory.requested_bytes) / kMiB);
+        show_hover_text("Blocks are rounded up to a power of two; the difference is rounding waste.");
+        ImGui::Text("Arena: %.1f / %.0f MiB%s", static_cast<double>(memory.arena_used_bytes) / kMiB, static_cast<double>(memory.arena_reserved_bytes) / kMiB,
+                    memory.huge_pages ? ", huge pages" : "");
+        show_hover_text("Address space carved into size-class blocks; freed blocks are reused, so this only grows.");
+        ImGui::Text("Outside the arena: %.1f MiB", static_cast<double>(memory.heap_bytes) / kMiB);
+        ImGui::Text("Allocations: %llu", static_cast<unsigned long long>(memory.allocations));
+        show_hover_text("Shared by every dish in the process.");
+    }
+
+    if (ImGui::CollapsingHeader("Overlap pairs")) {
+        struct KindLabel {
+            CircleKind kind;
+            const char* label;
+        };
+        constexpr KindLabel kKinds[] = {
+            {CircleKind::Creature, "Creature"},
+            {CircleKind::Pellet, "Food"},
+            {CircleKind::ToxicPellet, "Toxic"},
+            {CircleKind::DivisionPellet, "Division"},
+            {CircleKind::BoostParticle, "Boost"},
+        };
+        show_hover_text("Which kinds Box2D tracks overlaps between. Pairs without a creature feed nothing in the simulation.");
+        const CollisionFilter& filter = game.get_collision_filter();
+        for (int row = 0; row < static_cast<int>(array_size(kKinds)); ++row) {
+            ImGui::Text("%-9s", kKinds[row].label);
+            for (int column = 0; column <= row; ++column) {
+                ImGui::SameLine();
+                ImGui::PushID(row * 16 + column);
+                bool paired = filter.get_pair(kKinds[row].kind, kKinds[column].kind);
+                if (ImGui::Checkbox(kKinds[column].label, &paired)) {
+                    game.set_collision_pair(kKinds[row].kind, kKinds[column].kind, paired);
+                }
+                ImGui::PopID();
+            }
+        }
+    }
+
+    if (ImGui::CollapsingHeader("Quality of service", ImGuiTreeNodeFlags_DefaultOpen)) {
+        QosGovernor& qos = game.get_qos_governor();
+        bool qos_enabled = qos.get_settings().enabled;
+        if (ImGui::Checkbox("Governor", &qos_enabled)) {
+            qos.set_enabled(qos_enabled);
+        }
+        show_hover_text("Under load, lower the brain rate, then pellet sprinkling, then cap divisions to hold the target speed; restore them as load drops.");
+        ImGui::SliderFloat("Target speed (0 = time scale)", &qos.get_settings().target_speed, 0.0f, 20.0f, "%.1f");
+        ImGui::SliderFloat("Minimum brain rate (Hz)", &qos.get_settings().min_brain_hz, 0.1f, 10.0f, "%.1f");
+        ImGui::Text("Level %d  tick %.2f ms / budget %.2f ms", qos.get_level(), qos.get_last_tick_cost() * 1000.0f, qos.get_tick_budget() * 1000.0f);
+        if (qos.get_level() > 0) {
+            ImGui::Text("Running brains at %.2f Hz, food sprinkle %.2f/s",
+                        qos.governed_brain_hz(game.get_brain_updates_per_sim_second()),
+                        qos.governed_sprinkle_rate(game.get_sprinkle_rate_eatable()));
+            show_hover_text("The settings above keep their values; the governor scales them while degraded.");
+        }
+        if (qos.get_soft_cap() > 0) {
+            ImGui::Text("Soft creature cap: %zu", qos.get_soft_cap());
+        }
+        if (!qos.get_history().empty()) {
+            if (ImGui::BeginChild("QosHistory", ImVec2(0, 100), true)) {
+                for (const std::string& line : qos.get_history()) {
+                    ImGui::TextUnformatted(line.c_str());
+                }
+            }
+            ImGui::EndChild();
+        }
+    }
+
+    if (ImGui::CollapsingHeader("Innovation index", ImGuiTreeNodeFlags_DefaultOpen)) {
+        if (ImGui::SliderFloat("Compaction interval (s)", &state.performance.innovation_compaction_interval, 0.0f, 600.0f, "%.0f")) {
+            game.set_innovation_compaction_interval(state.performance.innovation_compaction_interval);
+        }
+        show_hover_text("How often node pairs no living genome uses are dropped from the index. 0 disables compaction.");
+        if (ImGui::Button("Compact now")) {
+            game.compact_innovations();
+        }
+        ImGui::SameLine();
+        ImGui::Text("Last compaction dropped %zu pairs", game.get_last_innovation_compaction_dropped());
+        ImGui::Text("Last innovation id: %d", game.get_innovation_registry().get_last_id());
+    }
+
+    if (ImGui::CollapsingHeader("Genome pool", ImGuiTreeNodeFlags_DefaultOpen)) {
+        ImGui::Text("Pooled genomes: %zu  reused: %zu", game.get_genome_pool().size(), game.get_genome_pool().get_reuse_count());
+        show_hover_text("Brains of dead creatures kept for reuse so new brains avoid fresh allocations.");
+        ImGui::Text("Creatures sharing a brain: %zu", game.get_shared_brain_count());
+        show_hover_text("Division clones still pointing at one genome; they split on their first mutation.");
+    }
+
+    ImGui::EndTabItem();
+}
 #endif // NDEBUG
 
 void render_spawning_controls(Game& game, UiState& state) {
@@ -777,6 +1038,12 @@ void render_spawning_controls(Game& game, UiState& state) {
 
 void render_ui(sf::RenderWindow& window, sf::View& view, Game& game) {
     static UiState state;
+    static const Game* state_game = nullptr;
+    if (state_game != &game) {
+        // Switching dishes: reload every control from the newly viewed dish.
+        state = UiState{};
+        state_game = &game;
+    }
     initialize_state(state, game);
 
     render_overview_window(game, state);
@@ -804,8 +1071,44 @@ void render_ui(sf::RenderWindow& window, sf::View& view, Game& game) {
     if (ImGui::BeginTabBar("ControlsTabs")) {
         render_simulation_tab(game, state);
         render_mutation_tab(game, state);
+        render_performance_tab(game, state);
         ImGui::EndTabBar();
     }
 #endif
     ImGui::End();
 }
+
+void render_dish_picker(DishPool& pool, IslandModel& islands, std::size_t& active_dish) {
+    if (pool.size() <= 1) {
+        return;
+    }
+
+    ImGui::Begin("Dishes");
+    for (std::size_t i = 0; i < pool.size(); ++i) {
+        const Game& dish = pool.dish(i);
+        const std::string label = "Dish " + std::to_string(i) +
+                                  "  creatures: " + std::to_string(dish.get_creature_count()) +
+                                  "  max gen: " + std::to_string(dish.get_max_generation());
+        if (ImGui::Selectable(label.c_str(), active_dish == i)) {
+            active_dish = i;
+        }
+    }
+    show_hover_text("Every dish keeps running; pick which one to view and control.");
+
+    ImGui::SeparatorText("Island migration");
+    IslandModel::Settings& migration = islands.get_settings();
+    ImGui::Checkbox("Migrate between dishes", &migration.enabled);
+    show_hover_text("Periodically sends each dish's top creatures to the next dish in a ring.");
+    ImGui::SliderFloat("Interval (sim s)", &migration.interval, 5.0f, 600.0f, "%.0f", ImGuiSliderFlags_Logarithmic);
+    ImGui::SliderInt("Migrants per dish", &migration.migrants_per_exchange, 1, 20);
+    int rank = static_cast<int>(migration.rank);
+    constexpr const char* kRankLabels[] = {"Oldest", "Largest"};
+    if (ImGui::Combo("Pick migrants by", &rank, kRankLabels, array_size(kRankLabels))) {
+        migration.rank = static_cast<Game::MigrantRank>(rank);
+    }
+    if (ImGui::Button("Migrate now")) {
+        islands.migrate_now();
+    }
+    ImGui::Text("Migrations so far: %d", islands.get_exchange_count());
+    ImGui::End();
+}
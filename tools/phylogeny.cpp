@@ -0,0 +1,233 @@
+// Rebuilds lineages from an event trace written with --trace.
+//   phylogeny TRACE              summary: totals, largest clades, deepest lineage
+//   phylogeny --csv TRACE        one row per creature
+//   phylogeny --newick ID TRACE  Newick tree below creature ID (branch lengths in seconds)
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "event_trace.hpp"
+
+namespace {
+constexpr double TICKS_PER_SECOND = 60.0;
+
+struct Creature {
+    std::uint64_t parent = 0;
+    std::uint32_t birth_tick = 0;
+    std::uint32_t death_tick = 0;
+    bool dead = false;
+    event_trace::DeathCause cause = event_trace::DeathCause::Removed;
+    std::uint32_t eats = 0;
+    std::vector<std::uint64_t> children;
+};
+
+using Lineages = std::unordered_map<std::uint64_t, Creature>;
+
+struct Totals {
+    std::uint64_t births = 0;
+    std::uint64_t deaths = 0;
+    std::uint64_t eats = 0;
+    std::uint64_t divisions = 0;
+    std::uint32_t last_tick = 0;
+};
+
+Lineages read_lineages(event_trace::Reader& reader, Totals& totals) {
+    Lineages lineages;
+    event_trace::Event event;
+    while (reader.next(event)) {
+        totals.last_tick = std::max(totals.last_tick, event.tick);
+        switch (event.type) {
+            case event_trace::EventType::Birth: {
+                ++totals.births;
+                Creature& creature = lineages[event.subject];
+                creature.parent = event.other;
+                creature.birth_tick = event.tick;
+                if (event.other != 0) {
+                    lineages[event.other].children.push_back(event.subject);
+                }
+                break;
+            }
+            case event_trace::EventType::Death: {
+                ++totals.deaths;
+                Creature& creature = lineages[event.subject];
+                creature.dead = true;
+                creature.death_tick = event.tick;
+                creature.cause = static_cast<event_trace::DeathCause>(event.detail);
+                break;
+            }
+            case event_trace::EventType::Eat:
+                ++totals.eats;
+                ++lineages[event.subject].eats;
+                break;
+            case event_trace::EventType::Division:
+                ++totals.divisions;
+                break;
+        }
+    }
+    return lineages;
+}
+
+// Descendant counts and depths without recursion; lineages can be thousands deep.
+void measure_clades(const Lineages& lineages,
+                    std::unordered_map<std::uint64_t, std::size_t>& clade_sizes,
+                    std::unordered_map<std::uint64_t, std::size_t>& depths) {
+    std::vector<std::uint64_t> order;
+    order.reserve(lineages.size());
+    std::vector<std::uint64_t> stack;
+    for (const auto& [id, creature] : lineages) {
+        if (creature.parent == 0 || !lineages.count(creature.parent)) {
+            depths[id] = 0;
+            stack.push_back(id);
+        }
+    }
+    while (!stack.empty()) {
+        const std::uint64_t id = stack.back();
+        stack.pop_back();
+        order.push_back(id);
+        for (std::uint64_t child : lineages.at(id).children) {
+            depths[child] = depths[id] + 1;
+            stack.push_back(child);
+        }
+    }
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        std::size_t size = 1;
+        for (std::uint64_t child : lineages.at(*it).children) {
+            size += clade_sizes[child];
+        }
+        clade_sizes[*it] = size;
+    }
+}
+
+const char* cause_name(const Creature& creature) {
+    if (!creature.dead) return "alive";
+    switch (creature.cause) {
+        case event_trace::DeathCause::Poisoned: return "poisoned";
+        case event_trace::DeathCause::Eaten: return "eaten";
+        case event_trace::DeathCause::Removed: break;
+    }
+    return "removed";
+}
+
+void print_summary(const Lineages& lineages, const Totals& totals) {
+    std::unordered_map<std::uint64_t, std::size_t> clade_sizes;
+    std::unordered_map<std::uint64_t, std::size_t> depths;
+    measure_clades(lineages, clade_sizes, depths);
+
+    std::vector<std::pair<std::size_t, std::uint64_t>> roots;
+    std::pair<std::size_t, std::uint64_t> deepest{0, 0};
+    for (const auto& [id, creature] : lineages) {
+        if (creature.parent == 0 || !lineages.count(creature.parent)) {
+            roots.emplace_back(clade_sizes[id], id);
+        }
+        deepest = std::max(deepest, std::make_pair(depths[id], id));
+    }
+    std::sort(roots.rbegin(), roots.rend());
+
+    std::cout << "ticks: " << totals.last_tick << " (" << totals.last_tick / TICKS_PER_SECOND << " s)\n"
+              << "births: " << totals.births << "  divisions: " << totals.divisions
+              << "  deaths: " << totals.deaths << "  eats: " << totals.eats << "\n"
+              << "founders: " << roots.size() << "\n"
+              << "deepest lineage: " << deepest.first << " divisions, ending at creature " << deepest.second << "\n"
+              << "largest clades (founder: creatures):\n";
+    for (std::size_t i = 0; i < std::min<std::size_t>(10, roots.size()); ++i) {
+        std::cout << "  " << roots[i].second << ": " << roots[i].first << "\n";
+    }
+}
+
+void print_csv(const Lineages& lineages) {
+    std::vector<std::uint64_t> ids;
+    ids.reserve(lineages.size());
+    for (const auto& entry : lineages) {
+        ids.push_back(entry.first);
+    }
+    std::sort(ids.begin(), ids.end());
+    std::cout << "id,parent,birth_tick,death_tick,fate,eats,children\n";
+    for (std::uint64_t id : ids) {
+        const Creature& c = lineages.at(id);
+        std::cout << id << ',' << c.parent << ',' << c.birth_tick << ',' << (c.dead ? std::to_string(c.death_tick) : "")
+                  << ',' << cause_name(c) << ',' << c.eats << ',' << c.children.size() << '\n';
+    }
+}
+
+void print_newick(const Lineages& lineages, std::uint64_t root) {
+    // Iterative post-order walk; each frame remembers how many children were emitted.
+    std::vector<std::pair<std::uint64_t, std::size_t>> stack{{root, 0}};
+    while (!stack.empty()) {
+        auto& [id, next_child] = stack.back();
+        const Creature& creature = lineages.at(id);
+        if (next_child == 0 && !creature.children.empty()) {
+            std::cout << '(';
+        }
+        if (next_child < creature.children.size()) {
+            if (next_child > 0) {
+                std::cout << ',';
+            }
+            const std::uint64_t child = creature.children[next_child++];
+            stack.emplace_back(child, 0);
+            continue;
+        }
+        if (!creature.children.empty()) {
+            std::cout << ')';
+        }
+        std::cout << id;
+        if (creature.parent != 0 && lineages.count(creature.parent)) {
+            const double branch = (creature.birth_tick - lineages.at(creature.parent).birth_tick) / TICKS_PER_SECOND;
+            std::cout << ':' << branch;
+        }
+        stack.pop_back();
+    }
+    std::cout << ";\n";
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    enum class Mode { Summary, Csv, Newick } mode = Mode::Summary;
+    std::uint64_t newick_root = 0;
+    std::string path;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--csv") {
+            mode = Mode::Csv;
+        } else if (arg == "--newick" && i + 1 < argc) {
+            mode = Mode::Newick;
+            newick_root = std::strtoull(argv[++i], nullptr, 10);
+        } else {
+            path = arg;
+        }
+    }
+    if (path.empty()) {
+        std::cerr << "Usage: " << argv[0] << " [--csv | --newick ID] TRACE\n";
+        return 1;
+    }
+
+    event_trace::Reader reader;
+    std::string error;
+    if (!reader.open(path, error)) {
+        std::cerr << error << "\n";
+        return 1;
+    }
+    Totals totals;
+    const Lineages lineages = read_lineages(reader, totals);
+
+    switch (mode) {
+        case Mode::Summary:
+            print_summary(lineages, totals);
+            break;
+        case Mode::Csv:
+            print_csv(lineages);
+            break;
+        case Mode::Newick:
+            if (!lineages.count(newick_root)) {
+                std::cerr << "No creature " << newick_root << " in " << path << "\n";
+                return 1;
+            }
+            print_newick(lineages, newick_root);
+            break;
+    }
+    return 0;
+}
@@ -0,0 +1,73 @@
+// Prints a telemetry log written with --telemetry as CSV, or a short summary with --summary.
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "telemetry.hpp"
+
+int main(int argc, char** argv) {
+    bool summary = false;
+    std::string path;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--summary") {
+            summary = true;
+        } else if (path.empty()) {
+            path = arg;
+        } else {
+            path.clear();
+            break;
+        }
+    }
+    if (path.empty()) {
+        std::cerr << "Usage: " << argv[0] << " [--summary] LOG\n";
+        return 1;
+    }
+
+    telemetry::Reader reader;
+    std::string error;
+    if (!reader.open(path, error)) {
+        std::cerr << error << "\n";
+        return 1;
+    }
+
+    const auto& columns = reader.get_columns();
+    if (!summary) {
+        for (std::size_t c = 0; c < columns.size(); ++c) {
+            std::cout << (c ? "," : "") << columns[c].name;
+        }
+        std::cout << '\n';
+    }
+
+    std::size_t rows = 0;
+    std::size_t chunks = 0;
+    std::vector<double> last_row(columns.size(), 0.0);
+    std::vector<std::vector<double>> values;
+    while (reader.next_chunk(values)) {
+        ++chunks;
+        const std::size_t chunk_rows = values.empty() ? 0 : values[0].size();
+        for (std::size_t r = 0; r < chunk_rows; ++r) {
+            for (std::size_t c = 0; c < columns.size(); ++c) {
+                last_row[c] = values[c][r];
+                if (!summary) {
+                    std::cout << (c ? "," : "") << values[c][r];
+                }
+            }
+            if (!summary) {
+                std::cout << '\n';
+            }
+        }
+        rows += chunk_rows;
+    }
+
+    if (summary) {
+        std::cout << path << ": " << rows << " rows in " << chunks << " chunks, " << columns.size() << " columns\n";
+        if (rows > 0) {
+            std::cout << "last row:\n";
+            for (std::size_t c = 0; c < columns.size(); ++c) {
+                std::cout << "  " << columns[c].name << " = " << last_row[c] << '\n';
+            }
+        }
+    }
+    return 0;
+}